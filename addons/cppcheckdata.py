@@ -8,7 +8,9 @@ License: No restrictions, use this as you need.
 
 import argparse
 import json
+import mmap
 import os
+import struct
 import sys
 import subprocess
 
@@ -1180,6 +1182,162 @@ class Standards:
         )
 
 
+class _DumpElement:
+    """
+    Element of a binary dump file. It provides the part of the
+    ElementTree.Element interface that is used to load the dump data.
+    """
+
+    __slots__ = ('tag', 'attrib', '_children')
+
+    def __init__(self, tag, attrib):
+        self.tag = tag
+        self.attrib = attrib
+        self._children = []
+
+    def get(self, key, default=None):
+        return self.attrib.get(key, default)
+
+    def __iter__(self):
+        return iter(self._children)
+
+    def __len__(self):
+        return len(self._children)
+
+    def clear(self):
+        self._children = []
+
+
+class _BinaryDump:
+    """
+    Reader for dump files written with --dump-format=binary.
+    The format is described in lib/binarydump.h. The trailer holds the
+    offsets of the sections, so single sections are loaded on demand.
+    """
+
+    MAGIC = b'CPPCHKDU'
+    VERSION = 1
+
+    @staticmethod
+    def open(filename):
+        """
+        Return a reader for the file or None if it is not a binary dump file.
+        """
+        with open(filename, 'rb') as f:
+            if f.read(len(_BinaryDump.MAGIC)) != _BinaryDump.MAGIC:
+                return None
+            return _BinaryDump(mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ))
+
+    def __init__(self, data):
+        self.data = data
+        version = struct.unpack_from('<I', data, len(self.MAGIC))[0]
+        if version != self.VERSION:
+            raise ValueError('unsupported binary dump version %d' % version)
+        pos = struct.unpack_from('<Q', data, len(data) - 8)[0]
+        if data[pos] != ord('I'):
+            raise ValueError('invalid binary dump file')
+        pos += 1
+        self.shapes = []
+        count, pos = self._varint(pos)
+        for _ in range(count):
+            tag, pos = self._string(pos)
+            names = []
+            attr_count, pos = self._varint(pos)
+            for _ in range(attr_count):
+                name, pos = self._string(pos)
+                names.append(name)
+            self.shapes.append((tag, names))
+        self.sections = []
+        count, pos = self._varint(pos)
+        for _ in range(count):
+            tag, pos = self._string(pos)
+            offset, pos = self._varint(pos)
+            self.sections.append((tag, offset))
+        # the root element starts after the magic and the version
+        self.root = next(self.iterparse(len(self.MAGIC) + 4))[1]
+
+    def _varint(self, pos):
+        data = self.data
+        result = 0
+        shift = 0
+        while True:
+            b = data[pos]
+            pos += 1
+            result |= (b & 0x7f) << shift
+            if b < 0x80:
+                return result, pos
+            shift += 7
+
+    def _string(self, pos):
+        size, pos = self._varint(pos)
+        return self.data[pos:pos+size].decode('utf-8'), pos + size
+
+    def iterparse(self, pos):
+        """
+        Iterate over the ('start', element) and ('end', element) events of the
+        element at the offset pos and its children like ElementTree.iterparse().
+        """
+        data = self.data
+        shapes = self.shapes
+        stack = []
+        while True:
+            kind = data[pos]
+            pos += 1
+            if kind == 0x45: # 'E'
+                element = stack.pop()
+                yield 'end', element
+                if not stack:
+                    return
+                continue
+            b = data[pos]
+            if b < 0x80:
+                shape = b
+                pos += 1
+            else:
+                shape, pos = self._varint(pos)
+            b = data[pos]
+            if b < 0x80:
+                size = b
+                pos += 1
+            else:
+                size, pos = self._varint(pos)
+            tag, names = shapes[shape]
+            if names:
+                attrib = dict(zip(names, data[pos:pos+size].decode('utf-8').split('\0')))
+            else:
+                attrib = {}
+            pos += size
+            element = _DumpElement(tag, attrib)
+            if stack:
+                stack[-1]._children.append(element)
+            yield 'start', element
+            if kind == 0x53: # 'S'
+                stack.append(element)
+            else:
+                yield 'end', element
+                if not stack:
+                    return
+
+    def load(self, pos):
+        """
+        Load the element at the offset pos together with its children.
+        """
+        element = None
+        for event, node in self.iterparse(pos):
+            if element is None:
+                element = node
+        return element
+
+    def iterparse_sections(self, tag):
+        """
+        Iterate over the events of all sections with the given tag.
+        """
+        for section_tag, offset in self.sections:
+            if section_tag == tag:
+                for event in self.iterparse(offset):
+                    yield event
+
+
 class CppcheckData:
     """
     Class that makes cppcheck dump data available
@@ -1225,11 +1383,28 @@ class CppcheckData:
         """
         self.language = None
         self.filename = filename
-        self.rawTokens = []
+        self._rawTokens = None
         self.platform = None
         self.suppressions = []
-        self.files = [] # source files for elements occurred in this configuration
+        self._files = None # source files for elements occurred in this configuration
+        self._binary = _BinaryDump.open(filename)
+
+        if self._binary:
+            # The raw tokens are loaded when they are used
+            self.language = self._binary.root.get('language')
+            for tag, offset in self._binary.sections:
+                if tag == 'platform':
+                    self.platform = Platform(self._binary.load(offset))
+                elif tag == 'suppressions':
+                    for suppressions_node in self._binary.load(offset):
+                        self.suppressions.append(Suppression(suppressions_node))
+        else:
+            self._load_xml()
 
+        global current_dumpfile_suppressions
+        current_dumpfile_suppressions = self.suppressions
+
+    def _load_xml(self):
         platform_done = False
         rawtokens_done = False
         suppressions_done = False
@@ -1246,26 +1421,63 @@ class CppcheckData:
                 self.platform = Platform(node)
                 platform_done = True
             elif node.tag == 'rawtokens' and event == 'end':
-                for rawtokens_node in node:
-                    if rawtokens_node.tag == 'file':
-                        self.files.append(rawtokens_node.get('name'))
-                    elif rawtokens_node.tag == 'tok':
-                        tok = Token(rawtokens_node)
-                        tok.file = self.files[int(rawtokens_node.get('fileIndex'))]
-                        self.rawTokens.append(tok)
+                self._set_raw_tokens(node)
                 rawtokens_done = True
             elif node.tag == 'suppressions' and event == 'end':
                 for suppressions_node in node:
                     self.suppressions.append(Suppression(suppressions_node))
                 suppressions_done = True
 
-        global current_dumpfile_suppressions
-        current_dumpfile_suppressions = self.suppressions
+        if not rawtokens_done:
+            self._set_raw_tokens([])
+
+    def _set_raw_tokens(self, rawtokens):
+        self._files = []
+        self._rawTokens = []
+        for rawtokens_node in rawtokens:
+            if rawtokens_node.tag == 'file':
+                self._files.append(rawtokens_node.get('name'))
+            elif rawtokens_node.tag == 'tok':
+                tok = Token(rawtokens_node)
+                tok.file = self._files[int(rawtokens_node.get('fileIndex'))]
+                self._rawTokens.append(tok)
 
         # Set links between rawTokens.
-        for i in range(len(self.rawTokens)-1):
-            self.rawTokens[i+1].previous = self.rawTokens[i]
-            self.rawTokens[i].next = self.rawTokens[i+1]
+        for i in range(len(self._rawTokens)-1):
+            self._rawTokens[i+1].previous = self._rawTokens[i]
+            self._rawTokens[i].next = self._rawTokens[i+1]
+
+    def _load_raw_tokens(self):
+        if self._rawTokens is None:
+            rawtokens = []
+            for tag, offset in self._binary.sections:
+                if tag == 'rawtokens':
+                    rawtokens = self._binary.load(offset)
+            self._set_raw_tokens(rawtokens)
+
+    @property
+    def rawTokens(self):
+        """
+        Return the list of rawToken elements.
+        """
+        self._load_raw_tokens()
+        return self._rawTokens
+
+    @rawTokens.setter
+    def rawTokens(self, value):
+        self._rawTokens = value
+
+    @property
+    def files(self):
+        """
+        Return the source files for elements occurred in this configuration.
+        """
+        self._load_raw_tokens()
+        return self._files
+
+    @files.setter
+    def files(self, value):
+        self._files = value
 
     @property
     def configurations(self):
@@ -1296,7 +1508,11 @@ class CppcheckData:
         # Use iterable objects to traverse XML tree for dump files incrementally.
         # Iterative approach is required to avoid large memory consumption.
         # Calling .clear() is necessary to let the element be garbage collected.
-        for event, node in ElementTree.iterparse(self.filename, events=('start', 'end')):
+        if self._binary:
+            events = self._binary.iterparse_sections('dump')
+        else:
+            events = ElementTree.iterparse(self.filename, events=('start', 'end'))
+        for event, node in events:
             # Serialize new configuration node
             if node.tag == 'dump':
                 if event == 'start':
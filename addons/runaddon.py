@@ -3,14 +3,73 @@ import cppcheck
 import runpy
 import sys
 import os
+import io
+import json
+import traceback
+
+
+def run_addon(addon, code):
+    # Reset the state left behind by the previous dump file
+    del cppcheck.__checkers__[:]
+    cppcheckdata.EXIT_CODE = 0
+    cppcheckdata.current_dumpfile_suppressions = []
+
+    exitcode = 0
+    try:
+        exec(code, {'__name__': '__main__', '__file__': addon, '__builtins__': __builtins__})
+        # Run registered checkers
+        cppcheck.runcheckers()
+        exitcode = cppcheckdata.EXIT_CODE
+    except SystemExit as e:
+        if e.code is None:
+            exitcode = 0
+        elif isinstance(e.code, int):
+            exitcode = e.code
+        else:
+            print(e.code, file=sys.stderr)
+            exitcode = 1
+    except Exception:  # pylint: disable=broad-except
+        traceback.print_exc()
+        exitcode = 1
+    return exitcode
+
+
+def serve(addon):
+    # Handle one request per line until stdin is closed:
+    #   {"args": ["--cli", "file.dump"]}
+    # Every request is answered with one line:
+    #   {"exitcode": 0, "output": "<stdout and stderr of the addon>"}
+    with open(addon, 'rt', encoding='utf-8') as f:
+        code = compile(f.read(), addon, 'exec')
+    stdout = sys.stdout
+    for line in sys.stdin:
+        if not line.strip():
+            continue
+        request = json.loads(line)
+        sys.argv = [addon] + request['args']
+        output = io.StringIO()
+        sys.stdout = output
+        sys.stderr = output
+        try:
+            exitcode = run_addon(addon, code)
+        finally:
+            sys.stdout = stdout
+            sys.stderr = sys.__stderr__
+        stdout.write(json.dumps({'exitcode': exitcode, 'output': output.getvalue()}) + '\n')
+        stdout.flush()
+
 
 if __name__ == '__main__':
     addon = sys.argv[1]
     __addon_name__ = os.path.splitext(os.path.basename(addon))[0]
     sys.argv.pop(0)
 
+    if sys.argv[1:] == ['--server']:
+        serve(addon)
+        sys.exit(0)
+
     runpy.run_path(addon, run_name='__main__')
 
     # Run registered checkers
     cppcheck.runcheckers()
-    sys.exit(cppcheckdata.EXIT_CODE)
\ No newline at end of file
+    sys.exit(cppcheckdata.EXIT_CODE)
@@ -0,0 +1,195 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "addonserver.h"
+
+#include "config.h"
+#include "json.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+AddonServer::~AddonServer()
+{
+    for (auto &p : mProcesses)
+        stop(p.second, false);
+}
+
+CppCheck::ExecuteAddonFn AddonServer::getExecuteAddon()
+{
+    return [this](const std::string &exe, const std::vector<std::string> &serverArgs, const std::vector<std::string> &args, std::string &output, int &exitcode) {
+        return execute(exe, serverArgs, args, output, exitcode);
+    };
+}
+
+bool AddonServer::execute(const std::string &exe, const std::vector<std::string> &serverArgs, const std::vector<std::string> &args, std::string &output, int &exitcode)
+{
+    std::string key = exe;
+    for (const std::string &arg : serverArgs)
+        key += '\n' + arg;
+
+    Process &process = mProcesses[key];
+    if (process.failed)
+        return false;
+    if (process.pid == -1 && !start(process, exe, serverArgs)) {
+        process.failed = true;
+        return false;
+    }
+    if (!request(process, args, output, exitcode)) {
+        stop(process, true);
+        process.failed = true;
+        output.clear();
+        return false;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+
+bool AddonServer::start(Process & /*process*/, const std::string & /*exe*/, const std::vector<std::string> & /*serverArgs*/)
+{
+    return false;
+}
+
+bool AddonServer::request(Process & /*process*/, const std::vector<std::string> & /*args*/, std::string & /*output*/, int & /*exitcode*/)
+{
+    return false;
+}
+
+void AddonServer::stop(Process & /*process*/, bool /*kill*/)
+{}
+
+#else
+
+bool AddonServer::start(Process &process, const std::string &exe, const std::vector<std::string> &serverArgs)
+{
+    int fds[2];
+#ifdef SOCK_CLOEXEC
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        return false;
+#else
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        return false;
+    // the servers of the other workers must not inherit the socket or they keep it open
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+#ifdef SO_NOSIGPIPE
+    const int on = 1;
+    setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    // only async-signal-safe functions may be called in the child of a multithreaded process
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(exe.c_str()));
+    for (const std::string &arg : serverArgs)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // the output of a request is sent back in the response - anything else is discarded
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (dup2(fds[1], STDIN_FILENO) == -1 || dup2(fds[1], STDOUT_FILENO) == -1 || devnull == -1 || dup2(devnull, STDERR_FILENO) == -1)
+            _exit(EXIT_FAILURE);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    close(fds[1]);
+    process.pid = pid;
+    process.fd = fds[0];
+    return true;
+}
+
+bool AddonServer::request(Process &process, const std::vector<std::string> &args, std::string &output, int &exitcode)
+{
+    picojson::array jsonArgs;
+    for (const std::string &arg : args)
+        jsonArgs.emplace_back(arg);
+    picojson::object req;
+    req["args"] = picojson::value(std::move(jsonArgs));
+    const std::string line = picojson::value(std::move(req)).serialize() + '\n';
+
+    for (std::size_t pos = 0; pos < line.size();) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t n = send(process.fd, line.data() + pos, line.size() - pos, MSG_NOSIGNAL);
+#else
+        const ssize_t n = send(process.fd, line.data() + pos, line.size() - pos, 0);
+#endif
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        pos += static_cast<std::size_t>(n);
+    }
+
+    std::string response;
+    char buffer[4096];
+    while (response.empty() || response.back() != '\n') {
+        const ssize_t n = read(process.fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        response.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    picojson::value res;
+    if (!picojson::parse(res, response).empty() || !res.is<picojson::object>())
+        return false;
+    const picojson::object &obj = res.get<picojson::object>();
+    const auto exitcodeIt = obj.find("exitcode");
+    const auto outputIt = obj.find("output");
+    if (exitcodeIt == obj.cend() || !exitcodeIt->second.is<std::int64_t>() || outputIt == obj.cend() || !outputIt->second.is<std::string>())
+        return false;
+    exitcode = static_cast<int>(exitcodeIt->second.get<std::int64_t>());
+    output = outputIt->second.get<std::string>();
+    return true;
+}
+
+void AddonServer::stop(Process &process, bool kill)
+{
+    if (process.pid == -1)
+        return;
+    // the server exits when its stdin is closed
+    close(process.fd);
+    if (kill)
+        ::kill(process.pid, SIGKILL);
+    int status;
+    while (waitpid(process.pid, &status, 0) == -1 && errno == EINTR) {}
+    process.pid = -1;
+    process.fd = -1;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADDONSERVER_H
+#define ADDONSERVER_H
+
+#include "cppcheck.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * @brief Long-lived addon processes (--addon-server)
+ *
+ * An addon server is started once per addon with "runaddon.py <addon> --server" and
+ * then receives the arguments for every dump file as a JSON line on its stdin. It
+ * answers with a JSON line holding the exit code and the output of the addon, which
+ * is the same as the output of an addon that is started for a single file. This
+ * saves the startup of the interpreter and the import of the addon modules for every
+ * file. A server that cannot be started or that fails is not used again so the
+ * addon is executed the usual way. It is not thread-safe - every worker thread needs
+ * its own instance. It is only available on POSIX systems.
+ */
+class AddonServer {
+public:
+    AddonServer() = default;
+    ~AddonServer();
+
+    AddonServer(const AddonServer &) = delete;
+    AddonServer& operator=(const AddonServer &) = delete;
+
+    /**
+     * Execute an addon by the server started with @p exe and @p serverArgs.
+     * @return false if there is no working server
+     */
+    bool execute(const std::string &exe, const std::vector<std::string> &serverArgs, const std::vector<std::string> &args, std::string &output, int &exitcode);
+
+    /** @return the callback for CppCheck::setExecuteAddon() */
+    CppCheck::ExecuteAddonFn getExecuteAddon();
+
+private:
+    struct Process {
+        int pid{-1};
+        /** socket connected to stdin and stdout of the server */
+        int fd{-1};
+        bool failed{};
+    };
+
+    static bool start(Process &process, const std::string &exe, const std::vector<std::string> &serverArgs);
+    static bool request(Process &process, const std::vector<std::string> &args, std::string &output, int &exitcode);
+    /** @param kill kill the server instead of waiting until it is done */
+    static void stop(Process &process, bool kill);
+
+    std::map<std::string, Process> mProcesses;
+};
+
+/// @}
+
+#endif // ADDONSERVER_H
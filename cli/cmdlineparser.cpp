@@ -517,11 +517,42 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         else if (std::strncmp(argv[i],"--addon-python=", 15) == 0)
             mSettings.addonPython.assign(argv[i]+15);
 
+        else if (std::strcmp(argv[i], "--addon-server") == 0)
+            mSettings.addonServer = true;
+
         else if (std::strcmp(argv[i],"--analyze-all-vs-configs") == 0) {
             mSettings.analyzeAllVsConfigs = true;
             mAnalyzeAllVsConfigsSetOnCmdLine = true;
         }
 
+        else if (std::strncmp(argv[i], "--analyzer-info-format=", 23) == 0) {
+            const std::string format = argv[i] + 23;
+            if (format == "xml")
+                mSettings.analyzerInfoFormat = Settings::AnalyzerInfoFormat::xml;
+            else if (format == "binary")
+                mSettings.analyzerInfoFormat = Settings::AnalyzerInfoFormat::binary;
+            else {
+                mLogger.printError("unknown '--analyzer-info-format' value '" + format + "'.");
+                return Result::Fail;
+            }
+        }
+
+        else if (std::strncmp(argv[i], "--cache-dir=", 12) == 0) {
+            std::string path = Path::fromNativeSeparators(argv[i] + 12);
+            if (path.empty()) {
+                mLogger.printError("no path has been specified for --cache-dir");
+                return Result::Fail;
+            }
+            if (endsWith(path, '/'))
+                path.pop_back();
+            mSettings.cacheDir = std::move(path);
+        }
+
+        else if (std::strncmp(argv[i], "--cache-max-size=", 17) == 0) {
+            if (!parseNumberArg(argv[i], 17, mSettings.cacheMaxSize))
+                return Result::Fail;
+        }
+
         // Check configuration
         else if (std::strcmp(argv[i], "--check-config") == 0)
             mSettings.checkConfiguration = true;
@@ -569,6 +600,21 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         else if (std::strncmp(argv[i], "--checkers-report=", 18) == 0)
             mSettings.checkersReportFilename = argv[i] + 18;
 
+        else if (std::strncmp(argv[i], "--checks-jobs=", 14) == 0) {
+            unsigned int tmp;
+            if (!parseNumberArg(argv[i], 14, tmp))
+                return Result::Fail;
+            if (tmp == 0) {
+                mLogger.printError("argument for '--checks-jobs' must be greater than 0.");
+                return Result::Fail;
+            }
+            if (tmp > 1024) {
+                mLogger.printError("argument for '--checks-jobs' is allowed to be 1024 at max.");
+                return Result::Fail;
+            }
+            mSettings.checksJobs = tmp;
+        }
+
         else if (std::strncmp(argv[i], "--checks-max-time=", 18) == 0) {
             if (!parseNumberArg(argv[i], 18, mSettings.checksMaxTime, true))
                 return Result::Fail;
@@ -605,6 +651,21 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
             }
         }
 
+        else if (std::strncmp(argv[i], "--config-jobs=", 14) == 0) {
+            unsigned int tmp;
+            if (!parseNumberArg(argv[i], 14, tmp))
+                return Result::Fail;
+            if (tmp == 0) {
+                mLogger.printError("argument for '--config-jobs' must be greater than 0.");
+                return Result::Fail;
+            }
+            if (tmp > 1024) {
+                mLogger.printError("argument for '--config-jobs' is allowed to be 1024 at max.");
+                return Result::Fail;
+            }
+            mSettings.configJobs = tmp;
+        }
+
         else if (std::strncmp(argv[i], "--cppcheck-build-dir=", 21) == 0) {
             std::string path = Path::fromNativeSeparators(argv[i] + 21);
             if (path.empty()) {
@@ -678,6 +739,18 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         else if (std::strcmp(argv[i], "--dump") == 0)
             mSettings.dump = true;
 
+        else if (std::strncmp(argv[i], "--dump-format=", 14) == 0) {
+            const std::string format = argv[i] + 14;
+            if (format == "xml")
+                mSettings.dumpFormat = Settings::DumpFormat::xml;
+            else if (format == "binary")
+                mSettings.dumpFormat = Settings::DumpFormat::binary;
+            else {
+                mLogger.printError("unknown '--dump-format' value '" + format + "'.");
+                return Result::Fail;
+            }
+        }
+
         else if (std::strcmp(argv[i], "--emit-duplicates") == 0)
             mSettings.emitDuplicates = true;
 
@@ -1006,6 +1079,9 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 return Result::Fail;
         }
 
+        else if (std::strcmp(argv[i], "--memstats") == 0)
+            mSettings.memstats = true;
+
         else if (std::strcmp(argv[i],"--no-analyze-all-vs-configs") == 0) {
             mSettings.analyzeAllVsConfigs = false;
             mAnalyzeAllVsConfigsSetOnCmdLine = true;
@@ -1564,11 +1640,32 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
                 return Result::Fail;
         }
 
+        else if (std::strncmp(argv[i], "--valueflow-jobs=", 17) == 0) {
+            unsigned int tmp;
+            if (!parseNumberArg(argv[i], 17, tmp))
+                return Result::Fail;
+            if (tmp == 0) {
+                mLogger.printError("argument for '--valueflow-jobs' must be greater than 0.");
+                return Result::Fail;
+            }
+            if (tmp > 1024) {
+                mLogger.printError("argument for '--valueflow-jobs' is allowed to be 1024 at max.");
+                return Result::Fail;
+            }
+            mSettings.valueFlowJobs = tmp;
+        }
+
         else if (std::strncmp(argv[i], "--valueflow-max-iterations=", 27) == 0) {
             if (!parseNumberArg(argv[i], 27, mSettings.vfOptions.maxIterations))
                 return Result::Fail;
         }
 
+        else if (std::strcmp(argv[i], "--valueflow-stats") == 0)
+            mSettings.valueFlowStats = true;
+
+        else if (std::strcmp(argv[i], "--valueflow-worklist") == 0)
+            mSettings.vfOptions.worklist = true;
+
         else if (std::strcmp(argv[i], "-v") == 0 || std::strcmp(argv[i], "--verbose") == 0)
             mSettings.verbose = true;
 
@@ -1701,6 +1798,17 @@ CmdLineParser::Result CmdLineParser::parseFromArgs(int argc, const char* const a
         return Result::Fail;
     }
 
+    if (!mSettings.cacheDir.empty()) {
+        if (mSettings.buildDir.empty()) {
+            mLogger.printError("--cache-dir requires --cppcheck-build-dir.");
+            return Result::Fail;
+        }
+        if (!Path::isDirectory(mSettings.cacheDir)) {
+            mLogger.printError("Directory '" + mSettings.cacheDir + "' specified by --cache-dir argument has to be existent.");
+            return Result::Fail;
+        }
+    }
+
     // Print error only if we have "real" command and expect files
     if (mPathNames.empty() && project.guiProject.pathNames.empty() && project.fileSettings.empty()) {
         // TODO: this message differs from the one reported in fillSettingsFromArgs()
@@ -1760,6 +1868,27 @@ void CmdLineParser::printHelp() const
         "                         addon json files or through this command line option.\n"
         "                         If not present, Cppcheck will try \"python3\" first and\n"
         "                         then \"python\".\n"
+        "    --addon-server\n"
+        "                         Execute the Python addons in a long-lived process per\n"
+        "                         worker thread instead of starting the interpreter for\n"
+        "                         every file. The results are the same. Not used with\n"
+        "                         --executor=process.\n"
+        "    --analyzer-info-format=<format>\n"
+        "                         Format of the analysis results in the\n"
+        "                         --cppcheck-build-dir:\n"
+        "                          * xml: XML (default)\n"
+        "                          * binary: Compact binary format which is faster to\n"
+        "                            load in the whole program analysis.\n"
+        "    --cache-dir=<dir>\n"
+        "                         Result cache folder that can be shared by several\n"
+        "                         Cppcheck processes (i.e. CI agents). Results are looked\n"
+        "                         up by the hash of the preprocessed code and the\n"
+        "                         settings when the --cppcheck-build-dir has no result\n"
+        "                         for a file. Requires --cppcheck-build-dir.\n"
+        "    --cache-max-size=<n>\n"
+        "                         Maximum size of the --cache-dir in MiB. The least\n"
+        "                         recently used results are removed after the analysis.\n"
+        "                         0 means unbounded. The default is 1024.\n"
         "    --cppcheck-build-dir=<dir>\n"
         "                         Cppcheck work folder. Advantages:\n"
         "                          * whole program analysis\n"
@@ -1801,6 +1930,13 @@ void CmdLineParser::printHelp() const
         "    --dump               Dump xml data for each translation unit. The dump\n"
         "                         files have the extension .dump and contain ast,\n"
         "                         tokenlist, symboldatabase, valueflow.\n"
+        "    --dump-format=<format>\n"
+        "                         Format of the dump files that are written for --dump\n"
+        "                         and the addons:\n"
+        "                          * xml: XML (default)\n"
+        "                          * binary: Compact binary format which is faster to\n"
+        "                            write and to load. It is read by the addons that\n"
+        "                            use cppcheckdata.py.\n"
         "    -D<ID>               Define preprocessor symbol. Unless --max-configs or\n"
         "                         --force is used, Cppcheck will only check the given\n"
         "                         configuration when -D is used.\n"
@@ -1901,6 +2037,8 @@ void CmdLineParser::printHelp() const
         "    --max-ctu-depth=N    Max depth in whole program analysis. The default value\n"
         "                         is 2. A larger value will mean more errors can be found\n"
         "                         but also means the analysis will be slower.\n"
+        "    --memstats           Print the number of ValueFlow values and the memory\n"
+        "                         used for them for each checked file.\n"
         "    --output-file=<file> Write results to file, rather than standard error.\n"
         "    --output-format=<format>\n"
         "                        Specify the output format. The available formats are:\n"
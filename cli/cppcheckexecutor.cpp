@@ -22,6 +22,7 @@
 
 #include "cppcheckexecutor.h"
 
+#include "addonserver.h"
 #include "analyzerinfo.h"
 #include "checkersreport.h"
 #include "cmdlinelogger.h"
@@ -32,7 +33,9 @@
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "filesettings.h"
+#include "headercache.h"
 #include "path.h"
+#include "resultcache.h"
 #include "sarifreport.h"
 #include "settings.h"
 #include "singleexecutor.h"
@@ -49,6 +52,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib> // EXIT_SUCCESS and EXIT_FAILURE
 #include <ctime>
@@ -444,9 +448,14 @@ int CppCheckExecutor::check_internal(const Settings& settings, Suppressions& sup
     if (!settings.checkersReportFilename.empty())
         std::remove(settings.checkersReportFilename.c_str());
 
+    // used by the single executor and the whole program analysis
+    AddonServer addonServer;
     CppCheck cppcheck(settings, supprs, stdLogger, timerResults.get(), true, executeCommand);
+    if (settings.addonServer)
+        cppcheck.setExecuteAddon(addonServer.getExecuteAddon());
 
     unsigned int returnValue = 0;
+    std::size_t duplicateCount = 0;
     if (settings.useSingleJob()) {
         // Single process
         SingleExecutor executor(cppcheck, mFiles, mFileSettings, settings, supprs, stdLogger, timerResults.get());
@@ -456,16 +465,40 @@ int CppCheckExecutor::check_internal(const Settings& settings, Suppressions& sup
         if (settings.executor == Settings::ExecutorType::Thread) {
             ThreadExecutor executor(mFiles, mFileSettings, settings, supprs, stdLogger, timerResults.get(), CppCheckExecutor::executeCommand);
             returnValue = executor.check();
+            duplicateCount = executor.getDuplicateCount();
         }
 #endif
 #if defined(HAS_THREADING_MODEL_FORK)
         if (settings.executor == Settings::ExecutorType::Process) {
             ProcessExecutor executor(mFiles, mFileSettings, settings, supprs, stdLogger, timerResults.get(), CppCheckExecutor::executeCommand);
             returnValue = executor.check();
+            duplicateCount = executor.getDuplicateCount();
         }
 #endif
     }
 
+    if (!settings.cacheDir.empty()) {
+        const ResultCache resultCache(settings.cacheDir);
+        if (settings.cacheMaxSize > 0 && !Settings::terminated())
+            resultCache.evict(static_cast<std::uint64_t>(settings.cacheMaxSize) * 1024 * 1024);
+
+        if (!settings.quiet) {
+            const ResultCache::Statistics stats = ResultCache::getStatistics();
+            static_cast<ErrorLogger&>(stdLogger).reportOut("Result cache: " + std::to_string(stats.hits) + " hit(s), " + std::to_string(stats.misses) + " miss(es), " +
+                                                           std::to_string(stats.stores) + " stored, " + std::to_string(stats.evictions) + " evicted", Color::Reset);
+        }
+    }
+
+    if (!settings.useSingleJob() && (settings.showtime == Settings::ShowTime::SUMMARY || settings.showtime == Settings::ShowTime::TOP5_SUMMARY))
+        static_cast<ErrorLogger&>(stdLogger).reportOut("Duplicate messages dropped: " + std::to_string(duplicateCount), Color::Reset);
+
+    if (settings.showtime == Settings::ShowTime::SUMMARY || settings.showtime == Settings::ShowTime::TOP5_SUMMARY) {
+        // the processes of the process executor each have their own cache
+        const HeaderCache::Statistics stats = HeaderCache::instance().getStatistics();
+        if (stats.hits + stats.misses > 0)
+            static_cast<ErrorLogger&>(stdLogger).reportOut("Header cache: " + std::to_string(stats.hits) + " hit(s), " + std::to_string(stats.misses) + " miss(es)", Color::Reset);
+    }
+
     // TODO: show time *after* the whole program analysis
     if (timerResults) {
         if (settings.showtime == Settings::ShowTime::SUMMARY)
@@ -25,7 +25,9 @@
 #include "suppressions.h"
 
 #include <cassert>
+#include <functional>
 #include <sstream>
+#include <string>
 #include <utility>
 
 struct FileSettings;
@@ -37,6 +39,16 @@ Executor::Executor(const std::list<FileWithDetails> &files, const std::list<File
     assert(!(!files.empty() && !fileSettings.empty()));
 }
 
+static std::uint64_t fnv1a64(const std::string &str)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const char c : str) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 // TODO: this logic is duplicated in CppCheck::reportErr()
 bool Executor::hasToLog(const ErrorMessage &msg)
 {
@@ -46,17 +58,21 @@ bool Executor::hasToLog(const ErrorMessage &msg)
     if (!mSuppressions.nomsg.isSuppressed(msg, {}))
     {
         // TODO: there should be no need for verbose and default messages here
-        std::string errmsg = msg.toString(mSettings.verbose, mSettings.templateFormat, mSettings.templateLocation);
+        const std::string errmsg = msg.toString(mSettings.verbose, mSettings.templateFormat, mSettings.templateLocation);
         if (errmsg.empty())
             return false;
 
         if (mSettings.emitDuplicates)
             return true;
 
-        std::lock_guard<std::mutex> lg(mErrorListSync);
-        if (mErrorList.emplace(std::move(errmsg)).second) {
+        // only the hash of the message is stored - two independent 64-bit hashes make collisions practically impossible
+        const MessageHash hash{fnv1a64(errmsg), std::hash<std::string>{}(errmsg)};
+        ErrorListShard &shard = mErrorList[(hash.first >> 32) % mErrorList.size()];
+        std::lock_guard<std::mutex> lg(shard.sync);
+        if (shard.hashes.insert(hash).second) {
             return true;
         }
+        ++mDuplicateCount;
     }
     return false;
 }
@@ -19,10 +19,12 @@
 #ifndef EXECUTOR_H
 #define EXECUTOR_H
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <list>
 #include <mutex>
-#include <string>
 #include <unordered_set>
 
 class Settings;
@@ -60,6 +62,11 @@ public:
      */
     void reportStatus(std::size_t fileindex, std::size_t filecount, std::size_t sizedone, std::size_t sizetotal);
 
+    /** Number of messages that were dropped because they have already been reported */
+    std::size_t getDuplicateCount() const {
+        return mDuplicateCount;
+    }
+
 protected:
     /**
      * @brief Check if message is being suppressed and unique.
@@ -76,9 +83,30 @@ protected:
     TimerResults *mTimerResults;
 
 private:
-    std::mutex mErrorListSync;
-    // TODO: store hashes instead of the full messages
-    std::unordered_set<std::string> mErrorList;
+    /** 128-bit hash of a formatted message */
+    struct MessageHash {
+        std::uint64_t first;
+        std::uint64_t second;
+
+        bool operator==(const MessageHash &other) const {
+            return first == other.first && second == other.second;
+        }
+    };
+
+    struct MessageHashHasher {
+        std::size_t operator()(const MessageHash &hash) const {
+            return static_cast<std::size_t>(hash.first);
+        }
+    };
+
+    /** The reported messages are split into shards with separate locks so the reporting threads rarely contend */
+    struct ErrorListShard {
+        std::mutex sync;
+        std::unordered_set<MessageHash, MessageHashHasher> hashes;
+    };
+
+    std::array<ErrorListShard, 16> mErrorList;
+    std::atomic<std::size_t> mDuplicateCount{};
 };
 
 /// @}
@@ -28,6 +28,7 @@
 #include "errorlogger.h"
 #include "errortypes.h"
 #include "filesettings.h"
+#include "resultcache.h"
 #include "settings.h"
 #include "suppressions.h"
 #include "timer.h"
@@ -47,11 +48,12 @@
 #include <map>
 #include <memory>
 #include <sstream>
-#include <sys/select.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #include <utility>
+#include <vector>
 #include <fcntl.h>
 
 
@@ -65,9 +67,6 @@
 
 enum class Color : std::uint8_t;
 
-// NOLINTNEXTLINE(misc-unused-using-decls) - required for FD_ZERO
-using std::memset;
-
 
 ProcessExecutor::ProcessExecutor(const std::list<FileWithDetails> &files, const std::list<FileSettings>& fileSettings, const Settings &settings, Suppressions &suppressions, ErrorLogger &errorLogger, TimerResults* timerResults, CppCheck::ExecuteCmdFn executeCommand)
     : Executor(files, fileSettings, settings, suppressions, errorLogger, timerResults)
@@ -76,12 +75,16 @@ ProcessExecutor::ProcessExecutor(const std::list<FileWithDetails> &files, const
     assert(mSettings.jobs > 1);
 }
 
+// the buffered messages of a child are written to the pipe when the buffer exceeds this size or the previous write is older than this
+static const std::size_t maxPipeBufferSize = 64 * 1024;
+static const std::chrono::milliseconds maxPipeFlushInterval{100};
+
 namespace {
     class PipeWriter : public ErrorLogger {
     public:
-        enum PipeSignal : std::uint8_t {REPORT_OUT='1',REPORT_ERROR='2',REPORT_SUPPR_INLINE='3',REPORT_SUPPR='4',CHILD_END='5',REPORT_METRIC='6',REPORT_TIMER='7'};
+        enum PipeSignal : std::uint8_t {REPORT_OUT='1',REPORT_ERROR='2',REPORT_SUPPR_INLINE='3',REPORT_SUPPR='4',CHILD_END='5',REPORT_METRIC='6',REPORT_TIMER='7',REPORT_RESULT_CACHE='8'};
 
-        explicit PipeWriter(int pipe, bool debug) : mWpipe(pipe), mDebug(debug) {}
+        explicit PipeWriter(int pipe, bool debug) : mWpipe(pipe), mDebug(debug), mLastFlush(std::chrono::steady_clock::now()) {}
 
         void reportOut(const std::string &outmsg, Color c) override {
             writeToPipe(REPORT_OUT, static_cast<char>(c) + outmsg);
@@ -91,7 +94,7 @@ namespace {
             writeToPipe(REPORT_ERROR, msg.serialize());
         }
 
-        void writeSuppr(const SuppressionList &supprs) const {
+        void writeSuppr(const SuppressionList &supprs) {
             for (const auto& suppr : supprs.getSuppressions())
             {
                 if (suppr.isInline)
@@ -105,7 +108,7 @@ namespace {
             writeToPipe(REPORT_METRIC, metric);
         }
 
-        void writeTimer(const TimerResults* timerResults) const {
+        void writeTimer(const TimerResults* timerResults) {
             if (!timerResults)
                 return;
 
@@ -117,8 +120,14 @@ namespace {
             }
         }
 
-        void writeEnd(const std::string& str) const {
+        void writeResultCacheStatistics() {
+            const ResultCache::Statistics stats = ResultCache::getStatistics();
+            writeToPipe(REPORT_RESULT_CACHE, std::to_string(stats.hits) + ";" + std::to_string(stats.misses) + ";" + std::to_string(stats.stores));
+        }
+
+        void writeEnd(const std::string& str) {
             writeToPipe(CHILD_END, str);
+            flush();
         }
 
     private:
@@ -137,56 +146,63 @@ namespace {
         }
 
         // TODO: how to log file name in error?
-        void writeToPipeInternal(PipeSignal type, const void* data, std::size_t to_write) const
+        void writeToPipeInternal(const char* data, std::size_t to_write)
         {
-            const ssize_t bytes_written = write(mWpipe, data, to_write);
-            if (bytes_written <= 0) {
-                const int err = errno;
-                std::cerr << "#### ThreadExecutor::writeToPipeInternal() error for type " << static_cast<unsigned char>(type) << ": " << std::strerror(err) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-            // TODO: write until everything is written
-            if (bytes_written != to_write) {
-                std::cerr << "#### ThreadExecutor::writeToPipeInternal() error for type " << static_cast<unsigned char>(type) << ": insufficient data written (expected: " << to_write << " / got: " << bytes_written << ")" << std::endl;
-                std::exit(EXIT_FAILURE);
+            while (to_write > 0) {
+                const ssize_t bytes_written = write(mWpipe, data, to_write);
+                if (bytes_written <= 0) {
+                    if (bytes_written < 0 && errno == EINTR)
+                        continue;
+                    const int err = errno;
+                    std::cerr << "#### ThreadExecutor::writeToPipeInternal() error: " << std::strerror(err) << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+                data += bytes_written;
+                to_write -= static_cast<std::size_t>(bytes_written);
             }
         }
 
-        void writeToPipe(PipeSignal type, const std::string &data) const
+        /** Write the buffered messages to the pipe */
+        void flush()
+        {
+            if (!mBuffer.empty())
+                writeToPipeInternal(mBuffer.data(), mBuffer.size());
+            mBuffer.clear();
+            mLastFlush = std::chrono::steady_clock::now();
+        }
+
+        // the messages are buffered and written in batches to reduce the number of system calls.
+        // the age limit makes sure the messages of a long running analysis are not held back.
+        void writeToPipe(PipeSignal type, const std::string &data)
         {
             if (mDebug)
                 std::cout << "writeToPipe - " << static_cast<char>(type) << " - " << data << std::endl;
 
-            {
-                const auto t = static_cast<char>(type);
-                writeToPipeInternal(type, &t, 1);
-            }
+            mBuffer += static_cast<char>(type);
 
             const auto len = static_cast<unsigned int>(data.length());
-            {
-                static constexpr std::size_t l_size = sizeof(unsigned int);
-                writeToPipeInternal(type, &len, l_size);
-            }
+            mBuffer.append(reinterpret_cast<const char*>(&len), sizeof(len));
 
-            if (len > 0) // TODO: unexpected - write a warning?
-                writeToPipeInternal(type, data.c_str(), len);
+            mBuffer += data;
+
+            if (mBuffer.size() >= maxPipeBufferSize || std::chrono::steady_clock::now() - mLastFlush >= maxPipeFlushInterval)
+                flush();
         }
 
         const int mWpipe;
         const bool mDebug;
+        std::string mBuffer;
+        std::chrono::steady_clock::time_point mLastFlush;
     };
 }
 
-bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::string& filename)
+bool ProcessExecutor::handleRead(int rpipe, std::string &buffer, unsigned int &result, const std::string& filename)
 {
-    std::size_t bytes_to_read;
-    ssize_t bytes_read;
-
-    char type = 0;
-    bytes_to_read = sizeof(char);
-    bytes_read = read(rpipe, &type, bytes_to_read);
+    // read everything that is available - a child writes its messages in batches
+    char chunk[64 * 1024];
+    const ssize_t bytes_read = read(rpipe, chunk, sizeof(chunk));
     if (bytes_read <= 0) {
-        if (errno == EAGAIN)
+        if (bytes_read < 0 && (errno == EAGAIN || errno == EINTR))
             return true;
 
         // TODO: log details about failure
@@ -195,51 +211,40 @@ bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::str
         ++result;
         return false;
     }
-    if (bytes_read != bytes_to_read) {
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (type): insufficient data read (expected: " << bytes_to_read << " / got: " << bytes_read << ")" << std::endl;
-        std::exit(EXIT_FAILURE);
+    buffer.append(chunk, static_cast<std::size_t>(bytes_read));
+
+    // handle all complete messages
+    std::size_t pos = 0;
+    bool res = true;
+    while (res) {
+        unsigned int len = 0;
+        if (buffer.size() - pos < 1 + sizeof(len))
+            break;
+        std::memcpy(&len, buffer.data() + pos + 1, sizeof(len));
+        if (buffer.size() - pos - 1 - sizeof(len) < len)
+            break;
+        const char type = buffer[pos];
+        res = handleMessage(type, buffer.substr(pos + 1 + sizeof(len), len), result, filename);
+        pos += 1 + sizeof(len) + len;
     }
+    buffer.erase(0, pos);
+    return res;
+}
 
+bool ProcessExecutor::handleMessage(char type, const std::string &buf, unsigned int &result, const std::string& filename)
+{
     if (type != PipeWriter::REPORT_OUT &&
         type != PipeWriter::REPORT_ERROR &&
         type != PipeWriter::REPORT_SUPPR_INLINE &&
         type != PipeWriter::REPORT_SUPPR &&
         type != PipeWriter::CHILD_END &&
         type != PipeWriter::REPORT_METRIC &&
-        type != PipeWriter::REPORT_TIMER) {
+        type != PipeWriter::REPORT_TIMER &&
+        type != PipeWriter::REPORT_RESULT_CACHE) {
         std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") invalid type " << int(type) << std::endl;
         std::exit(EXIT_FAILURE);
     }
 
-    unsigned int len = 0;
-    bytes_to_read = sizeof(len);
-    bytes_read = read(rpipe, &len, bytes_to_read);
-    if (bytes_read <= 0) {
-        const int err = errno;
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (len) for type " << int(type) << ": " << std::strerror(err) << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-    if (bytes_read != bytes_to_read) {
-        std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (len) for type" << int(type) << ": insufficient data read (expected: " << bytes_to_read << " / got: " << bytes_read << ")"  << std::endl;
-        std::exit(EXIT_FAILURE);
-    }
-
-    std::string buf(len, '\0');
-    if (len > 0) { // TODO: unexpected - write a warning?
-        char *data_start = &buf[0];
-        bytes_to_read = len;
-        do {
-            bytes_read = read(rpipe, data_start, bytes_to_read);
-            if (bytes_read <= 0) {
-                const int err = errno;
-                std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") error (buf) for type" << int(type) << ": " << std::strerror(err) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-            bytes_to_read -= bytes_read;
-            data_start += bytes_read;
-        } while (bytes_to_read != 0);
-    }
-
     if (mSettings.debugipc)
         std::cout << "handleRead - " << type << " - " << buf << std::endl;
 
@@ -307,6 +312,15 @@ bool ProcessExecutor::handleRead(int rpipe, unsigned int &result, const std::str
             std::exit(EXIT_FAILURE);
         }
         mTimerResults->addResults(parts[0], std::chrono::milliseconds{strToInt<long>(parts[1])});
+    } else if (type == PipeWriter::REPORT_RESULT_CACHE) {
+        const auto parts = splitString(buf, ';');
+        if (parts.size() < 3)
+        {
+            // TODO: make this non-fatal
+            std::cerr << "#### ThreadExecutor::handleRead(" << filename << ") adding of result cache statistics failed - insufficient data" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        ResultCache::addStatistics({strToInt<std::size_t>(parts[0]), strToInt<std::size_t>(parts[1]), strToInt<std::size_t>(parts[2]), 0});
     }
 
     return res;
@@ -352,6 +366,8 @@ unsigned int ProcessExecutor::check()
     std::list<int> rpipes;
     std::map<pid_t, std::string> childFile;
     std::map<int, std::string> pipeFile;
+    // the data of incomplete messages
+    std::map<int, std::string> pipeBuffer;
     std::size_t processedsize = 0;
     auto iFile = mFiles.cbegin();
     auto iFileSettings = mFileSettings.cbegin();
@@ -392,6 +408,9 @@ unsigned int ProcessExecutor::check()
                 if (mTimerResults)
                     timerResults.reset(new TimerResults);
 
+                // the statistics of the parent are inherited
+                ResultCache::resetStatistics();
+
                 PipeWriter pipewriter(pipes[1], mSettings.debugipc);
                 CppCheck fileChecker(mSettings, supprs, pipewriter, timerResults.get(), false, mExecuteCommand);
                 unsigned int resultOfCheck = 0;
@@ -407,6 +426,9 @@ unsigned int ProcessExecutor::check()
 
                 pipewriter.writeTimer(timerResults.get());
 
+                if (!mSettings.cacheDir.empty())
+                    pipewriter.writeResultCacheStatistics();
+
                 pipewriter.writeEnd(std::to_string(resultOfCheck));
                 std::exit(EXIT_SUCCESS);
             }
@@ -424,48 +446,45 @@ unsigned int ProcessExecutor::check()
             }
         }
         if (!rpipes.empty()) {
-            fd_set rfds;
-            FD_ZERO(&rfds);
-            for (auto rp = rpipes.cbegin(); rp != rpipes.cend(); ++rp)
-                FD_SET(*rp, &rfds);
-            timeval tv; // for every second polling of load average condition
-            tv.tv_sec = 1;
-            tv.tv_usec = 0;
-            const int r = select(*std::max_element(rpipes.cbegin(), rpipes.cend()) + 1, &rfds, nullptr, nullptr, &tv);
+            std::vector<pollfd> pollfds;
+            pollfds.reserve(rpipes.size());
+            for (const int rp : rpipes)
+                pollfds.push_back({rp, POLLIN, 0});
+            // for every second polling of load average condition
+            const int r = poll(pollfds.data(), pollfds.size(), 1000);
 
             if (r > 0) {
-                auto rp = rpipes.cbegin();
-                while (rp != rpipes.cend()) {
-                    if (FD_ISSET(*rp, &rfds)) {
-                        std::string name;
-                        const auto p = utils::as_const(pipeFile).find(*rp);
+                for (const pollfd &pfd : pollfds) {
+                    if ((pfd.revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+                        continue;
+                    const int rp = pfd.fd;
+                    std::string name;
+                    const auto p = utils::as_const(pipeFile).find(rp);
+                    if (p != pipeFile.cend()) {
+                        name = p->second;
+                    }
+                    const bool readRes = handleRead(rp, pipeBuffer[rp], result, name);
+                    if (!readRes) {
+                        std::size_t size = 0;
                         if (p != pipeFile.cend()) {
-                            name = p->second;
-                        }
-                        const bool readRes = handleRead(*rp, result, name);
-                        if (!readRes) {
-                            std::size_t size = 0;
-                            if (p != pipeFile.cend()) {
-                                pipeFile.erase(p);
-                                const auto fs = std::find_if(mFiles.cbegin(), mFiles.cend(), [&name](const FileWithDetails& entry) {
-                                    return entry.path() == name;
-                                });
-                                if (fs != mFiles.end()) {
-                                    size = fs->size();
-                                }
+                            pipeFile.erase(p);
+                            const auto fs = std::find_if(mFiles.cbegin(), mFiles.cend(), [&name](const FileWithDetails& entry) {
+                                return entry.path() == name;
+                            });
+                            if (fs != mFiles.end()) {
+                                size = fs->size();
                             }
+                        }
 
-                            fileCount++;
-                            processedsize += size;
-                            if (!mSettings.quiet)
-                                Executor::reportStatus(fileCount, mFiles.size() + mFileSettings.size(), processedsize, totalfilesize);
-
-                            close(*rp);
-                            rp = rpipes.erase(rp);
-                        } else
-                            ++rp;
-                    } else
-                        ++rp;
+                        fileCount++;
+                        processedsize += size;
+                        if (!mSettings.quiet)
+                            Executor::reportStatus(fileCount, mFiles.size() + mFileSettings.size(), processedsize, totalfilesize);
+
+                        close(rp);
+                        pipeBuffer.erase(rp);
+                        rpipes.remove(rp);
+                    }
                 }
             }
         }
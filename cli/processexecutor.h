@@ -54,10 +54,17 @@ public:
 
 private:
     /**
-     * Read from the pipe, parse and handle what ever is in there.
-     * @return False in case of an recoverable error - will exit process on others
+     * Read from the pipe, parse and handle all complete messages.
+     * @param buffer the incomplete message data of the pipe
+     * @return False if the child is done or in case of an recoverable error - will exit process on others
      */
-    bool handleRead(int rpipe, unsigned int &result, const std::string& filename);
+    bool handleRead(int rpipe, std::string &buffer, unsigned int &result, const std::string& filename);
+
+    /**
+     * Handle a single message from the pipe.
+     * @return False if the child is done
+     */
+    bool handleMessage(char type, const std::string &buf, unsigned int &result, const std::string& filename);
 
     /**
      * @brief Check load average condition
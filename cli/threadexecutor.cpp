@@ -20,20 +20,31 @@
 
 #ifdef HAS_THREADING_MODEL_THREAD
 
+#include "addonserver.h"
+#include "color.h"
 #include "config.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
 #include "filesettings.h"
 #include "settings.h"
 #include "suppressions.h"
+#include "utils.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <deque>
+#include <fstream>
 #include <future>
+#include <iomanip>
 #include <iostream>
 #include <list>
+#include <map>
 #include <numeric>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -83,43 +94,114 @@ private:
     ErrorLogger &mErrorLogger;
 };
 
+static std::string getTimingsKey(const FileWithDetails *file, const FileSettings *fs)
+{
+    if (fs)
+        return fs->cfg + ':' + (fs->file.fsFileId() > 0 ? std::to_string(fs->file.fsFileId()) : "") + ':' + fs->sfilename();
+    return "::" + file->spath();
+}
+
+/**
+ * Read the durations (in milliseconds) of the files analyzed in a previous run.
+ * Each line of "timings.txt" in the build dir has the format "<ms>:<cfg>:<fsFileId>:<file>".
+ */
+static std::map<std::string, std::int64_t> readTimingsTxt(const std::string &buildDir)
+{
+    std::map<std::string, std::int64_t> timings;
+    std::ifstream fin(buildDir + "/timings.txt");
+    std::string line;
+    while (std::getline(fin, line)) {
+        const std::string::size_type sep = line.find(':');
+        if (sep == std::string::npos)
+            continue;
+        std::int64_t ms;
+        if (!strToInt(line.substr(0, sep), ms) || ms < 0)
+            continue;
+        timings[line.substr(sep + 1)] = ms;
+    }
+    return timings;
+}
+
+static void writeTimingsTxt(const std::string &buildDir, const std::map<std::string, std::int64_t> &timings)
+{
+    std::ofstream fout(buildDir + "/timings.txt");
+    for (const auto &t : timings)
+        fout << t.second << ':' << t.first << '\n';
+}
+
 class ThreadData
 {
 public:
     ThreadData(ThreadExecutor &threadExecutor, ErrorLogger &errorLogger, TimerResults *timerResults, const Settings &settings, Suppressions& supprs, const std::list<FileWithDetails> &files, const std::list<FileSettings> &fileSettings, CppCheck::ExecuteCmdFn executeCommand)
-        : mFiles(files), mFileSettings(fileSettings), mTimerResults(timerResults), mSettings(settings), mSuppressions(supprs), mExecuteCommand(std::move(executeCommand)), mLogForwarder(threadExecutor, errorLogger)
+        : mTimerResults(timerResults), mSettings(settings), mSuppressions(supprs), mExecuteCommand(std::move(executeCommand)), mLogForwarder(threadExecutor, errorLogger), mWorkers(settings.jobs)
     {
-        mItNextFile = mFiles.begin();
-        mItNextFileSettings = mFileSettings.begin();
-
-        mTotalFiles = mFiles.size() + mFileSettings.size();
-        mTotalFileSize = std::accumulate(mFiles.cbegin(), mFiles.cend(), std::size_t(0), [](std::size_t v, const FileWithDetails& p) {
+        std::vector<Job> jobs;
+        jobs.reserve(files.size() + fileSettings.size());
+        for (const FileWithDetails &file : files)
+            jobs.push_back({&file, nullptr, file.size(), getTimingsKey(&file, nullptr), 0});
+        for (const FileSettings &fs : fileSettings)
+            jobs.push_back({nullptr, &fs, 0, getTimingsKey(nullptr, &fs), 0});
+
+        mTotalFiles = jobs.size();
+        mTotalFileSize = std::accumulate(files.cbegin(), files.cend(), std::size_t(0), [](std::size_t v, const FileWithDetails& p) {
             return v + p.size();
         });
-    }
 
-    bool next(const FileWithDetails *&file, const FileSettings *&fs, std::size_t &fileSize) {
-        std::lock_guard<std::mutex> l(mFileSync);
-        if (mItNextFile != mFiles.end()) {
-            file = &(*mItNextFile);
-            fs = nullptr;
-            fileSize = mItNextFile->size();
-            ++mItNextFile;
-            return true;
-        }
-        if (mItNextFileSettings != mFileSettings.end()) {
-            file = nullptr;
-            fs = &(*mItNextFileSettings);
-            fileSize = 0;
-            ++mItNextFileSettings;
-            return true;
+        if (!mSettings.buildDir.empty())
+            mTimings = readTimingsTxt(mSettings.buildDir);
+
+        predictCost(jobs);
+
+        // The most expensive files are started first and are spread over the workers so the
+        // predicted cost of every worker is about the same.
+        std::stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) {
+            return a.cost > b.cost;
+        });
+        for (Job &job : jobs) {
+            const auto w = std::min_element(mWorkers.begin(), mWorkers.end(), [](const Worker &a, const Worker &b) {
+                return a.queuedCost < b.queuedCost;
+            });
+            w->queuedCost += job.cost;
+            w->queue.push_back(std::move(job));
         }
+    }
 
-        return false;
+    /**
+     * Get the next file for a worker. The worker takes the most expensive file from its own
+     * queue. If its queue is empty it steals the most expensive file from the worker that
+     * has the most queued work left.
+     */
+    bool next(std::size_t worker, const FileWithDetails *&file, const FileSettings *&fs, std::size_t &fileSize, std::string &timingsKey) {
+        Job job{};
+        if (!pop(mWorkers[worker], job)) {
+            bool stolen = false;
+            while (!stolen) {
+                Worker *victim = nullptr;
+                double victimCost = 0;
+                for (Worker &w : mWorkers) {
+                    std::lock_guard<std::mutex> l(w.sync);
+                    if (!w.queue.empty() && (!victim || w.queuedCost > victimCost)) {
+                        victim = &w;
+                        victimCost = w.queuedCost;
+                    }
+                }
+                if (!victim)
+                    return false;
+                stolen = pop(*victim, job);
+            }
+            ++mWorkers[worker].stolenFiles;
+        }
+        file = job.file;
+        fs = job.fs;
+        fileSize = job.size;
+        timingsKey = std::move(job.timingsKey);
+        return true;
     }
 
-    unsigned int check(const FileWithDetails *file, const FileSettings *fs) {
+    unsigned int check(std::size_t worker, const FileWithDetails *file, const FileSettings *fs) {
         CppCheck fileChecker(mSettings, mSuppressions, mLogForwarder, mTimerResults, false, mExecuteCommand);
+        if (mSettings.addonServer)
+            fileChecker.setExecuteAddon(mWorkers[worker].addonServer.getExecuteAddon());
 
         unsigned int result;
         if (fs) {
@@ -149,19 +231,107 @@ public:
         return result;
     }
 
-    void status(std::size_t fileSize) {
+    void status(std::size_t worker, std::size_t fileSize, std::string timingsKey, std::chrono::milliseconds duration) {
+        {
+            Worker &w = mWorkers[worker];
+            std::lock_guard<std::mutex> l(w.sync);
+            w.busy += duration;
+            ++w.checkedFiles;
+        }
+
         std::lock_guard<std::mutex> l(mFileSync);
+        mTimings[std::move(timingsKey)] = duration.count();
         mProcessedSize += fileSize;
         mProcessedFiles++;
         if (!mSettings.quiet)
             mLogForwarder.reportStatus(mProcessedFiles, mTotalFiles, mProcessedSize, mTotalFileSize);
     }
 
+    /** Store the durations of the analyzed files in the build dir */
+    void writeTimings() const {
+        if (!mSettings.buildDir.empty() && !Settings::terminated())
+            writeTimingsTxt(mSettings.buildDir, mTimings);
+    }
+
+    /** Report how much of the wall time each worker has been busy */
+    void reportUtilization(std::chrono::milliseconds wallTime) {
+        const auto asSeconds = [](std::chrono::milliseconds ms) {
+            return std::chrono::duration_cast<std::chrono::duration<double>>(ms).count();
+        };
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+        oss << "Thread executor wall time: " << asSeconds(wallTime) << "s";
+        for (std::size_t i = 0; i < mWorkers.size(); ++i) {
+            const Worker &w = mWorkers[i];
+            const double utilization = wallTime.count() > 0 ? (100.0 * w.busy.count() / wallTime.count()) : 100.0;
+            oss << "\nWorker " << (i + 1) << ": " << w.checkedFiles << " file(s) (" << w.stolenFiles << " stolen), busy " << asSeconds(w.busy) << "s (" << std::setprecision(1) << utilization << std::setprecision(3) << "%)";
+        }
+        mLogForwarder.reportOut(oss.str(), Color::Reset);
+    }
+
 private:
-    const std::list<FileWithDetails> &mFiles;
-    std::list<FileWithDetails>::const_iterator mItNextFile;
-    const std::list<FileSettings> &mFileSettings;
-    std::list<FileSettings>::const_iterator mItNextFileSettings;
+    struct Job
+    {
+        const FileWithDetails *file;
+        const FileSettings *fs;
+        std::size_t size;
+        std::string timingsKey;
+        double cost;
+    };
+
+    struct Worker
+    {
+        std::mutex sync;
+        std::deque<Job> queue;
+        double queuedCost{};
+
+        std::chrono::milliseconds busy{};
+        std::size_t checkedFiles{};
+        std::size_t stolenFiles{};
+
+        /** the addon servers are only used by the thread of the worker */
+        AddonServer addonServer;
+    };
+
+    static bool pop(Worker &w, Job &job) {
+        std::lock_guard<std::mutex> l(w.sync);
+        if (w.queue.empty())
+            return false;
+        job = std::move(w.queue.front());
+        w.queue.pop_front();
+        w.queuedCost -= job.cost;
+        return true;
+    }
+
+    /**
+     * The predicted cost of a file is its duration in a previous run. Files without a known
+     * duration are estimated from their size based on the files with a known duration.
+     */
+    void predictCost(std::vector<Job> &jobs) const {
+        double knownMs = 0;
+        double knownSize = 0;
+        const auto getSize = [](const Job &job) {
+            return static_cast<double>(job.fs ? job.fs->file.size() : job.size);
+        };
+
+        for (const Job &job : jobs) {
+            const auto it = mTimings.find(job.timingsKey);
+            if (it != mTimings.cend() && getSize(job) > 0) {
+                knownMs += static_cast<double>(it->second);
+                knownSize += getSize(job);
+            }
+        }
+        const double msPerByte = (knownSize > 0 && knownMs > 0) ? (knownMs / knownSize) : 1.0;
+
+        for (Job &job : jobs) {
+            const auto it = mTimings.find(job.timingsKey);
+            if (it != mTimings.cend())
+                job.cost = static_cast<double>(it->second);
+            else
+                job.cost = getSize(job) * msPerByte;
+        }
+    }
 
     std::size_t mProcessedFiles{};
     std::size_t mTotalFiles{};
@@ -175,20 +345,26 @@ private:
     CppCheck::ExecuteCmdFn mExecuteCommand;
 
     SyncLogForwarder mLogForwarder;
+
+    std::vector<Worker> mWorkers;
+    std::map<std::string, std::int64_t> mTimings;
 };
 
-static unsigned int STDCALL threadProc(ThreadData *data)
+static unsigned int STDCALL threadProc(ThreadData *data, std::size_t worker)
 {
     unsigned int result = 0;
 
     const FileWithDetails *file;
     const FileSettings *fs;
     std::size_t fileSize;
+    std::string timingsKey;
 
-    while (data->next(file, fs, fileSize)) {
-        result += data->check(file, fs);
+    while (data->next(worker, file, fs, fileSize, timingsKey)) {
+        const auto start = std::chrono::steady_clock::now();
+        result += data->check(worker, file, fs);
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
 
-        data->status(fileSize);
+        data->status(worker, fileSize, std::move(timingsKey), duration);
     }
 
     return result;
@@ -201,9 +377,11 @@ unsigned int ThreadExecutor::check()
 
     ThreadData data(*this, mErrorLogger, mTimerResults, mSettings, mSuppressions, mFiles, mFileSettings, mExecuteCommand);
 
+    const auto start = std::chrono::steady_clock::now();
+
     for (unsigned int i = 0; i < mSettings.jobs; ++i) {
         try {
-            threadFutures.emplace_back(std::async(std::launch::async, &threadProc, &data));
+            threadFutures.emplace_back(std::async(std::launch::async, &threadProc, &data, i));
         }
         catch (const std::system_error &e) {
             std::cerr << "#### ThreadExecutor::check exception :" << e.what() << std::endl;
@@ -215,6 +393,11 @@ unsigned int ThreadExecutor::check()
         return v + f.get();
     });
 
+    data.writeTimings();
+
+    if (mSettings.showtime == Settings::ShowTime::SUMMARY || mSettings.showtime == Settings::ShowTime::TOP5_SUMMARY)
+        data.reportUtilization(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start));
+
     return result;
 }
 
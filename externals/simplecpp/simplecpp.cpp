@@ -3145,7 +3145,7 @@ std::pair<simplecpp::FileData *, bool> simplecpp::FileDataCache::tryload(FileDat
         return {id_it->second, false};
     }
 
-    auto *const data = new FileData {path, TokenList(path, filenames, outputList)};
+    auto *const data = new FileData {path, mTokenizeCallback ? mTokenizeCallback(path, filenames, outputList) : TokenList(path, filenames, outputList)};
 
     if (dui.removeComments)
         data->tokens.removeComments();
@@ -505,6 +505,13 @@ namespace simplecpp {
             mLoadCallback = std::move(cb);
         }
 
+        /** Creates the tokens of a file that is not cached yet. By default the file is read and tokenized. */
+        using tokenize_callback_type = std::function<TokenList (const std::string &path, std::vector<std::string> &filenames, OutputList *outputList)>;
+
+        void set_tokenize_callback(tokenize_callback_type cb) {
+            mTokenizeCallback = std::move(cb);
+        }
+
     private:
         struct Impl;
         std::unique_ptr<Impl> mImpl;
@@ -516,6 +523,7 @@ namespace simplecpp {
         container_type mData;
         name_map_type mNameMap;
         load_callback_type mLoadCallback;
+        tokenize_callback_type mTokenizeCallback;
     };
 
     /** Converts character literal (including prefix, but not ud-suffix) to long long value.
@@ -19,21 +19,226 @@
 #include "analyzerinfo.h"
 
 #include "errorlogger.h"
+#include "errortypes.h"
 #include "filesettings.h"
+#include "parallel.h"
 #include "path.h"
+#include "resultcache.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstring>
 #include <exception>
 #include <iostream>
 #include <map>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "xml.h"
 
+// The binary analyzer information file consists of a header followed by records.
+//   header: magic, version (u32), hash (u64)
+//   record: type (char), size (u32), data
+// All integers are stored in little endian byte order.
+static const char binaryMagic[8] = {'C', 'P', 'P', 'C', 'H', 'K', 'A', 'I'};
+static constexpr std::uint32_t binaryVersion = 1;
+
+namespace {
+    enum BinaryRecord : char {
+        /** ErrorMessage::serialize() */
+        ErrorRecord = 'E',
+        /** check name size (u32), check name, file info */
+        FileInfoRecord = 'F',
+        /** hash (u64), analyzer information file - starts a TU in the whole program cache */
+        TranslationUnitRecord = 'T',
+        /** marks a complete file */
+        EndRecord = 'Z'
+    };
+
+    class BinaryReader {
+    public:
+        explicit BinaryReader(const std::string &data) : mData(data) {}
+
+        std::string readHeader(std::uint64_t &hash) {
+            if (mData.compare(0, sizeof(binaryMagic), binaryMagic, sizeof(binaryMagic)) != 0)
+                return "unexpected file format";
+            mPos = sizeof(binaryMagic);
+            std::uint64_t version = 0;
+            if (!read(version, 4) || !read(hash, 8))
+                return "incomplete header";
+            if (version != binaryVersion)
+                return "unsupported version " + std::to_string(version);
+            return "";
+        }
+
+        /** Read next record. Returns false if there is no complete record left. */
+        bool readRecord(char &type, const char *&data, std::size_t &size) {
+            if (mPos >= mData.size())
+                return false;
+            type = mData[mPos++];
+            std::uint64_t sz = 0;
+            if (!read(sz, 4) || sz > mData.size() - mPos)
+                return false;
+            data = mData.data() + mPos;
+            size = sz;
+            mPos += size;
+            return true;
+        }
+
+        static bool splitFileInfo(const char *data, std::size_t size, std::string &check, std::string &fileInfo) {
+            if (size < 4)
+                return false;
+            std::uint64_t checkSize = 0;
+            for (int i = 0; i < 4; ++i)
+                checkSize |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+            if (checkSize > size - 4)
+                return false;
+            check.assign(data + 4, checkSize);
+            fileInfo.assign(data + 4 + checkSize, size - 4 - checkSize);
+            return true;
+        }
+
+    private:
+        bool read(std::uint64_t &value, int bytes) {
+            if (mData.size() - mPos < static_cast<std::size_t>(bytes))
+                return false;
+            value = 0;
+            for (int i = 0; i < bytes; ++i)
+                value |= static_cast<std::uint64_t>(static_cast<unsigned char>(mData[mPos++])) << (8 * i);
+            return true;
+        }
+
+        const std::string &mData;
+        std::size_t mPos{};
+    };
+}
+
+static void writeInt(std::ostream &os, std::uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        os.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+static void writeRecord(std::ostream &os, BinaryRecord type, const std::string &data)
+{
+    os.put(type);
+    writeInt(os, data.size(), 4);
+    os << data;
+}
+
+static bool isBinary(const std::string &content)
+{
+    return content.compare(0, sizeof(binaryMagic), binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+static bool readFile(const std::string &filename, std::string &content)
+{
+    std::ifstream fin(filename, std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    std::ostringstream oss;
+    oss << fin.rdbuf();
+    content = oss.str();
+    return true;
+}
+
+static void writeFileInfoRecord(std::ostream &os, const std::string &check, const std::string &fileInfo)
+{
+    std::ostringstream data;
+    writeInt(data, check.size(), 4);
+    data << check << fileInfo;
+    writeRecord(os, FileInfoRecord, data.str());
+}
+
+// The whole program cache in the build dir holds the file info of all TUs of the previous whole
+// program analysis. It uses the binary analyzer information format with a TU record in front of the
+// file info records of each TU. Only the analyzer information files with a different hash are loaded.
+static const char wholeProgramCacheFile[] = "wholeprogram.cache";
+
+namespace {
+    struct WholeProgramCacheEntry {
+        std::uint64_t hash{};
+        /** check name and file info */
+        std::vector<std::pair<std::string, std::string>> fileInfo;
+    };
+}
+
+static std::map<std::string, WholeProgramCacheEntry> loadWholeProgramCache(const std::string &filename)
+{
+    std::map<std::string, WholeProgramCacheEntry> cache;
+    std::string content;
+    if (!readFile(filename, content))
+        return cache;
+
+    BinaryReader reader(content);
+    std::uint64_t hash;
+    if (!reader.readHeader(hash).empty())
+        return cache;
+    char type;
+    const char *data;
+    std::size_t size;
+    WholeProgramCacheEntry *entry = nullptr;
+    std::string check;
+    std::string fileInfo;
+    while (reader.readRecord(type, data, size)) {
+        if (type == EndRecord)
+            return cache;
+        if (type == TranslationUnitRecord && size > 8) {
+            const std::string record(data, size);
+            entry = &cache[record.substr(8)];
+            for (int i = 0; i < 8; ++i)
+                entry->hash |= static_cast<std::uint64_t>(static_cast<unsigned char>(record[i])) << (8 * i);
+        } else if (type == FileInfoRecord && entry && BinaryReader::splitFileInfo(data, size, check, fileInfo)) {
+            entry->fileInfo.emplace_back(check, fileInfo);
+        } else {
+            break;
+        }
+    }
+    // the cache is incomplete
+    cache.clear();
+    return cache;
+}
+
+/** Read the hash of an analyzer information file without loading the whole file */
+static bool readAnalyzerInfoHash(const std::string &filename, std::uint64_t &hash)
+{
+    std::ifstream fin(filename, std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    char buf[128];
+    fin.read(buf, sizeof(buf));
+    const std::string header(buf, static_cast<std::size_t>(fin.gcount()));
+    if (isBinary(header)) {
+        BinaryReader reader(header);
+        return reader.readHeader(hash).empty();
+    }
+    static const std::string hashAttr = "<analyzerinfo hash=\"";
+    const std::string::size_type start = header.find(hashAttr);
+    if (start == std::string::npos)
+        return false;
+    const std::string::size_type end = header.find('"', start + hashAttr.size());
+    if (end == std::string::npos)
+        return false;
+    return strToInt(header.substr(start + hashAttr.size(), end - start - hashAttr.size()), hash);
+}
+
+// TODO: discarding results on internalError doesn't make sense since that won't fix itself
+// Check for invalid license error or internal error, in which case we should retry analysis
+static const std::array<const char*, 3> s_retryIds{
+    "premium-invalidLicense",
+    "premium-internalError",
+    "internalError"
+};
+
+AnalyzerInformation::AnalyzerInformation(bool binary)
+    : mBinary(binary)
+{}
+
 AnalyzerInformation::~AnalyzerInformation()
 {
     close();
@@ -80,11 +285,25 @@ std::string AnalyzerInformation::getFilesTxt(const std::list<std::string> &sourc
 void AnalyzerInformation::close()
 {
     if (mOutputStream.is_open()) {
-        mOutputStream << "</analyzerinfo>\n";
+        if (mBinary)
+            writeRecord(mOutputStream, EndRecord, "");
+        else
+            mOutputStream << "</analyzerinfo>\n";
         mOutputStream.close();
     }
 }
 
+void AnalyzerInformation::storeInResultCache()
+{
+    if (!mResultCache || !mOutputStream.is_open())
+        return;
+    close();
+
+    std::string content;
+    if (readFile(mAnalyzerInfoFile, content))
+        mResultCache->store(mResultCacheKey, content);
+}
+
 std::string AnalyzerInformation::skipAnalysis(const tinyxml2::XMLDocument &analyzerInfoDoc, std::size_t hash, std::list<ErrorMessage> &errors)
 {
     const tinyxml2::XMLElement * const rootNode = analyzerInfoDoc.FirstChildElement();
@@ -104,14 +323,7 @@ std::string AnalyzerInformation::skipAnalysis(const tinyxml2::XMLDocument &analy
         if (std::strcmp(e->Name(), "error") != 0)
             continue;
 
-        // TODO: discarding results on internalError doesn't make sense since that won't fix itself
-        // Check for invalid license error or internal error, in which case we should retry analysis
-        static const std::array<const char*, 3> s_ids{
-            "premium-invalidLicense",
-            "premium-internalError",
-            "internalError"
-        };
-        for (const auto* id : s_ids)
+        for (const auto* id : s_retryIds)
         {
             // cppcheck-suppress useStlAlgorithm
             if (e->Attribute("id", id)) {
@@ -126,6 +338,63 @@ std::string AnalyzerInformation::skipAnalysis(const tinyxml2::XMLDocument &analy
     return "";
 }
 
+std::string AnalyzerInformation::skipAnalysis(const std::string &analyzerInfo, std::size_t hash, std::list<ErrorMessage> &errors)
+{
+    BinaryReader reader(analyzerInfo);
+    std::uint64_t fileHash = 0;
+    const std::string err = reader.readHeader(fileHash);
+    if (!err.empty())
+        return err;
+    if (fileHash != hash)
+        return "hash mismatch";
+
+    char type;
+    const char *data;
+    std::size_t size;
+    while (reader.readRecord(type, data, size)) {
+        if (type == EndRecord)
+            return "";
+        if (type != ErrorRecord)
+            continue;
+
+        ErrorMessage msg;
+        try {
+            msg.deserialize(std::string(data, size));
+        } catch (const InternalError &) {
+            errors.clear();
+            return "invalid error";
+        }
+        for (const auto* id : s_retryIds)
+        {
+            // cppcheck-suppress useStlAlgorithm
+            if (msg.id == id) {
+                errors.clear();
+                return std::string("'") + id + "' encountered";
+            }
+        }
+
+        errors.push_back(std::move(msg));
+    }
+
+    errors.clear();
+    return "incomplete file";
+}
+
+std::string AnalyzerInformation::loadAnalyzerInfo(const std::string &content, std::size_t hash, std::list<ErrorMessage> &errors, bool &loaded)
+{
+    loaded = true;
+    if (isBinary(content))
+        return skipAnalysis(content, hash, errors);
+
+    tinyxml2::XMLDocument analyzerInfoDoc;
+    const tinyxml2::XMLError xmlError = analyzerInfoDoc.Parse(content.data(), content.size());
+    if (xmlError != tinyxml2::XML_SUCCESS) {
+        loaded = false;
+        return tinyxml2::XMLDocument::ErrorIDToName(xmlError);
+    }
+    return skipAnalysis(analyzerInfoDoc, hash, errors);
+}
+
 std::string AnalyzerInformation::getAnalyzerInfoFileFromFilesTxt(std::istream& filesTxt, const std::string &sourcefile, const std::string &cfg, size_t fsFileId)
 {
     std::string line;
@@ -169,10 +438,10 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
     const std::string analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir,sourcefile,cfg,fsFileId);
 
     {
-        tinyxml2::XMLDocument analyzerInfoDoc;
-        const tinyxml2::XMLError xmlError = analyzerInfoDoc.LoadFile(analyzerInfoFile.c_str());
-        if (xmlError == tinyxml2::XML_SUCCESS) {
-            const std::string err = skipAnalysis(analyzerInfoDoc, hash, errors);
+        std::string content;
+        bool loaded = false;
+        const std::string err = readFile(analyzerInfoFile, content) ? loadAnalyzerInfo(content, hash, errors, loaded) : "";
+        if (loaded) {
             if (err.empty()) {
                 if (debug)
                     std::cout << "skipping analysis - loaded " << errors.size() << " cached finding(s) from '" << analyzerInfoFile << "' for '" << sourcefile <<  "'" << std::endl;
@@ -182,32 +451,69 @@ bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::st
                 std::cout << "discarding cached result from '" << analyzerInfoFile << "' for '" << sourcefile << "' - " << err << std::endl;
             }
         }
-        else if (xmlError != tinyxml2::XML_ERROR_FILE_NOT_FOUND) {
+        else if (!err.empty()) {
             if (debug)
-                std::cout << "discarding cached result - failed to load '" << analyzerInfoFile << "' for '" << sourcefile << "' (" << tinyxml2::XMLDocument::ErrorIDToName(xmlError) << ")" << std::endl;
+                std::cout << "discarding cached result - failed to load '" << analyzerInfoFile << "' for '" << sourcefile << "' (" << err << ")" << std::endl;
         }
         else if (debug)
             std::cout << "no cached result '" << analyzerInfoFile << "' for '" << sourcefile << "' found" << std::endl;
     }
 
-    mOutputStream.open(analyzerInfoFile);
+    if (mResultCache) {
+        mResultCacheKey = ResultCache::getKey(hash, sourcefile, cfg);
+        std::string content;
+        if (mResultCache->load(mResultCacheKey, content)) {
+            bool loaded = false;
+            const std::string err = loadAnalyzerInfo(content, hash, errors, loaded);
+            if (err.empty()) {
+                // the whole program analysis reads the TU.analyzerinfo file
+                std::ofstream fout(analyzerInfoFile, std::ios::binary);
+                fout << content;
+                if (debug)
+                    std::cout << "skipping analysis - loaded " << errors.size() << " cached finding(s) from result cache entry '" << mResultCacheKey << "' for '" << sourcefile << "'" << std::endl;
+                return false;
+            }
+            errors.clear();
+            if (debug)
+                std::cout << "discarding result cache entry '" << mResultCacheKey << "' for '" << sourcefile << "' - " << err << std::endl;
+        }
+        else if (debug)
+            std::cout << "no result cache entry '" << mResultCacheKey << "' for '" << sourcefile << "' found" << std::endl;
+    }
+
+    mAnalyzerInfoFile = analyzerInfoFile;
+    mOutputStream.open(analyzerInfoFile, mBinary ? (std::ios::out | std::ios::binary) : std::ios::out);
     if (!mOutputStream.is_open())
         throw std::runtime_error("failed to open '" + analyzerInfoFile + "'");
-    mOutputStream << "<?xml version=\"1.0\"?>\n";
-    mOutputStream << "<analyzerinfo hash=\"" << hash << "\">\n";
+    if (mBinary) {
+        mOutputStream.write(binaryMagic, sizeof(binaryMagic));
+        writeInt(mOutputStream, binaryVersion, 4);
+        writeInt(mOutputStream, hash, 8);
+    } else {
+        mOutputStream << "<?xml version=\"1.0\"?>\n";
+        mOutputStream << "<analyzerinfo hash=\"" << hash << "\">\n";
+    }
 
     return true;
 }
 
 void AnalyzerInformation::reportErr(const ErrorMessage &msg)
 {
-    if (mOutputStream.is_open())
+    if (!mOutputStream.is_open())
+        return;
+    if (mBinary)
+        writeRecord(mOutputStream, ErrorRecord, msg.serialize());
+    else
         mOutputStream << msg.toXML() << '\n';
 }
 
 void AnalyzerInformation::setFileInfo(const std::string &check, const std::string &fileInfo)
 {
-    if (mOutputStream.is_open() && !fileInfo.empty())
+    if (!mOutputStream.is_open() || fileInfo.empty())
+        return;
+    if (mBinary)
+        writeFileInfoRecord(mOutputStream, check, fileInfo);
+    else
         mOutputStream << "  <FileInfo check=\"" << check << "\">\n" << fileInfo << "  </FileInfo>\n";
 }
 
@@ -239,7 +545,7 @@ bool AnalyzerInformation::Info::parse(const std::string& filesTxtLine) {
     return true;
 }
 
-std::string AnalyzerInformation::processFilesTxt(const std::string& buildDir, const std::function<void(const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug)
+std::string AnalyzerInformation::readFilesTxt(const std::string& buildDir, std::vector<Info>& filesTxtInfos)
 {
     const std::string filesTxt(buildDir + "/files.txt");
     std::ifstream fin(filesTxt.c_str());
@@ -252,45 +558,184 @@ std::string AnalyzerInformation::processFilesTxt(const std::string& buildDir, co
         if (filesTxtInfo.afile.empty())
             return "empty afile from '" + filesTxt + "'";
 
-        const std::string xmlfile = buildDir + '/' + filesTxtInfo.afile;
+        filesTxtInfos.push_back(std::move(filesTxtInfo));
+    }
+    return "";
+}
+
+std::string AnalyzerInformation::processAnalyzerInfoFile(const std::string& buildDir, const Info& filesTxtInfo, const std::function<void(const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug)
+{
+    const std::string filesTxt(buildDir + "/files.txt");
+    const std::string xmlfile = buildDir + '/' + filesTxtInfo.afile;
+
+    std::string content;
+    if (!readFile(xmlfile, content)) {
+        /* FIXME: this can currently not be reported as an error because:
+         * - --clang does not generate any analyzer information - see #14456
+         * - markup files might not generate analyzer information
+         * - files with preprocessor errors might not generate analyzer information
+         */
+        if (debug)
+            std::cout << "'" + xmlfile + "' from '" + filesTxt + "' not found";
+        return "";
+    }
+
+    if (isBinary(content)) {
+        // only the file info is needed so the errors are skipped without parsing them
+        BinaryReader reader(content);
+        std::uint64_t hash;
+        std::string err = reader.readHeader(hash);
+        char type;
+        const char *data;
+        std::size_t size;
+        bool complete = false;
+        std::string check;
+        std::string fileInfo;
+        while (err.empty() && reader.readRecord(type, data, size)) {
+            if (type == EndRecord) {
+                complete = true;
+                break;
+            }
+            if (type != FileInfoRecord)
+                continue;
+            if (!BinaryReader::splitFileInfo(data, size, check, fileInfo)) {
+                err = "invalid FileInfo";
+                break;
+            }
+            const std::string xml = "<FileInfo>" + fileInfo + "</FileInfo>";
+            tinyxml2::XMLDocument doc;
+            if (doc.Parse(xml.data(), xml.size()) != tinyxml2::XML_SUCCESS) {
+                err = "failed to parse FileInfo";
+                break;
+            }
+            handler(check.c_str(), doc.FirstChildElement(), filesTxtInfo);
+        }
+        if (err.empty() && !complete)
+            err = "incomplete file";
+        if (!err.empty())
+            return err + " in '" + xmlfile + "' from '" + filesTxt + "'";
+        return "";
+    }
+
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError error = doc.Parse(content.data(), content.size());
+    if (error != tinyxml2::XML_SUCCESS)
+        return "failed to load '" + xmlfile + "' from '" + filesTxt + "'";
+
+    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
+    if (rootNode == nullptr)
+        return "no root node found in '" + xmlfile + "' from '" + filesTxt + "'";
 
-        tinyxml2::XMLDocument doc;
-        const tinyxml2::XMLError error = doc.LoadFile(xmlfile.c_str());
-        if (error == tinyxml2::XML_ERROR_FILE_NOT_FOUND) {
-            /* FIXME: this can currently not be reported as an error because:
-             * - --clang does not generate any analyzer information - see #14456
-             * - markup files might not generate analyzer information
-             * - files with preprocessor errors might not generate analyzer information
-             */
+    if (strcmp(rootNode->Name(), "analyzerinfo") != 0)
+        return "unexpected root node in '" + xmlfile + "' from '" + filesTxt + "'";
+
+    for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
+        if (std::strcmp(e->Name(), "FileInfo") != 0)
+            continue;
+        const char *checkattr = e->Attribute("check");
+        if (checkattr == nullptr) {
             if (debug)
-                std::cout << "'" + xmlfile + "' from '" + filesTxt + "' not found";
+                std::cout << "'check' attribute missing in 'FileInfo' in '" << xmlfile << "' from '" << filesTxt + "'";
             continue;
         }
+        handler(checkattr, e, filesTxtInfo);
+    }
+    return "";
+}
 
-        if (error != tinyxml2::XML_SUCCESS)
-            return "failed to load '" + xmlfile + "' from '" + filesTxt + "'";
-
-        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-        if (rootNode == nullptr)
-            return "no root node found in '" + xmlfile + "' from '" + filesTxt + "'";
+std::string AnalyzerInformation::processFilesTxt(const std::string& buildDir, const std::function<void(const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug)
+{
+    std::vector<Info> filesTxtInfos;
+    const std::string err = readFilesTxt(buildDir, filesTxtInfos);
+    if (!err.empty())
+        return err;
+
+    for (const Info& filesTxtInfo : filesTxtInfos) {
+        std::string fileErr = processAnalyzerInfoFile(buildDir, filesTxtInfo, handler, debug);
+        if (!fileErr.empty())
+            return fileErr;
+    }
 
-        if (strcmp(rootNode->Name(), "analyzerinfo") != 0)
-            return "unexpected root node in '" + xmlfile + "' from '" + filesTxt + "'";
+    // TODO: error on empty file?
+    return "";
+}
 
-        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "FileInfo") != 0)
-                continue;
-            const char *checkattr = e->Attribute("check");
-            if (checkattr == nullptr) {
-                if (debug)
-                    std::cout << "'check' attribute missing in 'FileInfo' in '" << xmlfile << "' from '" << filesTxt + "'";
-                continue;
+std::string AnalyzerInformation::processFilesTxt(const std::string& buildDir, const std::vector<Info>& filesTxtInfos, const std::function<void(std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug, unsigned int jobs)
+{
+    const std::string cacheFile = Path::join(buildDir, wholeProgramCacheFile);
+    const std::map<std::string, WholeProgramCacheEntry> cache = loadWholeProgramCache(cacheFile);
+
+    std::vector<WholeProgramCacheEntry> entries(filesTxtInfos.size());
+    std::vector<char> cached(filesTxtInfos.size(), 0);
+    std::vector<char> loaded(filesTxtInfos.size(), 0);
+    std::vector<std::string> errors(filesTxtInfos.size());
+    const std::vector<std::exception_ptr> exceptions = executeParallel(filesTxtInfos.size(), jobs, [&](std::size_t i) {
+        const Info &filesTxtInfo = filesTxtInfos[i];
+        WholeProgramCacheEntry &entry = entries[i];
+        const bool hasHash = readAnalyzerInfoHash(buildDir + '/' + filesTxtInfo.afile, entry.hash);
+
+        const auto it = hasHash ? cache.find(filesTxtInfo.afile) : cache.cend();
+        if (it != cache.cend() && it->second.hash == entry.hash) {
+            cached[i] = 1;
+            for (const std::pair<std::string, std::string> &fileInfo : it->second.fileInfo) {
+                const std::string xml = "<FileInfo>" + fileInfo.second + "</FileInfo>";
+                tinyxml2::XMLDocument doc;
+                if (doc.Parse(xml.data(), xml.size()) != tinyxml2::XML_SUCCESS) {
+                    errors[i] = "failed to parse FileInfo of '" + filesTxtInfo.afile + "' in '" + cacheFile + "'";
+                    return;
+                }
+                handler(i, fileInfo.first.c_str(), doc.FirstChildElement(), filesTxtInfo);
             }
-            handler(checkattr, e, filesTxtInfo);
+            return;
         }
+
+        errors[i] = processAnalyzerInfoFile(buildDir, filesTxtInfo, [&](const char* checkattr, const tinyxml2::XMLElement* e, const Info& info) {
+            handler(i, checkattr, e, info);
+            if (hasHash) {
+                tinyxml2::XMLPrinter printer(nullptr, true);
+                for (const tinyxml2::XMLNode *child = e->FirstChild(); child; child = child->NextSibling())
+                    child->Accept(&printer);
+                entry.fileInfo.emplace_back(checkattr, printer.CStr());
+            }
+        }, debug);
+        loaded[i] = hasHash && errors[i].empty();
+    });
+
+    // report the first failure in the order of files.txt
+    for (std::size_t i = 0; i < filesTxtInfos.size(); ++i) {
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        if (!errors[i].empty())
+            return errors[i];
     }
 
-    // TODO: error on empty file?
+    const std::size_t cacheHits = std::count(cached.cbegin(), cached.cend(), 1);
+    const std::size_t cacheMisses = std::count(loaded.cbegin(), loaded.cend(), 1);
+    if (debug)
+        std::cout << "whole program analysis - " << cacheHits << " of " << filesTxtInfos.size() << " file(s) loaded from '" << cacheFile << "'" << std::endl;
+
+    // only update the cache if TUs have been changed, added or removed
+    if (cacheMisses == 0 && cacheHits == cache.size())
+        return "";
+
+    std::ofstream fout(cacheFile, std::ios::out | std::ios::binary);
+    if (!fout.is_open())
+        return "";
+    fout.write(binaryMagic, sizeof(binaryMagic));
+    writeInt(fout, binaryVersion, 4);
+    writeInt(fout, 0, 8);
+    for (std::size_t i = 0; i < filesTxtInfos.size(); ++i) {
+        if (!cached[i] && !loaded[i])
+            continue;
+        std::ostringstream tu;
+        writeInt(tu, entries[i].hash, 8);
+        tu << filesTxtInfos[i].afile;
+        writeRecord(fout, TranslationUnitRecord, tu.str());
+        const WholeProgramCacheEntry &entry = cached[i] ? cache.at(filesTxtInfos[i].afile) : entries[i];
+        for (const std::pair<std::string, std::string> &fileInfo : entry.fileInfo)
+            writeFileInfoRecord(fout, fileInfo.first, fileInfo.second);
+    }
+    writeRecord(fout, EndRecord, "");
     return "";
 }
 
@@ -300,17 +745,20 @@ void AnalyzerInformation::reopen(const std::string &buildDir, const std::string
         return;
 
     const std::string analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir,sourcefile,cfg,fsFileId);
-    std::ifstream ifs(analyzerInfoFile);
-    if (!ifs.is_open())
+    std::string content;
+    if (!readFile(analyzerInfoFile, content))
         return;
 
-    std::ostringstream iss;
-    iss << ifs.rdbuf();
-    ifs.close();
-
-    std::string content = iss.str();
-    content.resize(content.find("</analyzerinfo>"));
+    mBinary = isBinary(content);
+    if (mBinary) {
+        // remove the end record - it is written again by close()
+        static const std::string endRecord{EndRecord, 0, 0, 0, 0};
+        if (content.size() >= endRecord.size() && content.compare(content.size() - endRecord.size(), endRecord.size(), endRecord) == 0)
+            content.resize(content.size() - endRecord.size());
+    }
+    else
+        content.resize(content.find("</analyzerinfo>"));
 
-    mOutputStream.open(analyzerInfoFile, std::ios::trunc);
+    mOutputStream.open(analyzerInfoFile, std::ios::out | std::ios::trunc | std::ios::binary);
     mOutputStream << content;
 }
@@ -28,8 +28,10 @@
 #include <functional>
 #include <list>
 #include <string>
+#include <vector>
 
 class ErrorMessage;
+class ResultCache;
 struct FileSettings;
 
 namespace tinyxml2 {
@@ -55,12 +57,20 @@ namespace tinyxml2 {
  */
 class CPPCHECKLIB AnalyzerInformation {
 public:
+    /** @param binary write the compact binary format instead of XML */
+    explicit AnalyzerInformation(bool binary = false);
     ~AnalyzerInformation();
 
     static void writeFilesTxt(const std::string &buildDir, const std::list<std::string> &sourcefiles, const std::list<FileSettings> &fileSettings);
 
     /** Close current TU.analyzerinfo file */
     void close();
+    /** Use @p resultCache as second level cache when there is no up-to-date TU.analyzerinfo file */
+    void setResultCache(const ResultCache* resultCache) {
+        mResultCache = resultCache;
+    }
+    /** Close current TU.analyzerinfo file and store it in the result cache */
+    void storeInResultCache();
     /**
      * @throws std::runtime_error thrown if the output file is already open or the output file cannot be opened
      */
@@ -84,6 +94,18 @@ public:
 
     static std::string processFilesTxt(const std::string& buildDir, const std::function<void(const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug = false);
 
+    /** Read the entries of files.txt in @p buildDir */
+    static std::string readFilesTxt(const std::string& buildDir, std::vector<Info>& filesTxtInfos);
+
+    /**
+     * Load the analyzer information of @p filesTxtInfos using up to @p jobs threads.
+     * The handler gets the index of the entry and is called concurrently for different entries.
+     * The file info of the TUs whose hash did not change is taken from the whole program cache
+     * in the build dir, which is updated afterwards.
+     * @return the first error in the order of @p filesTxtInfos
+     */
+    static std::string processFilesTxt(const std::string& buildDir, const std::vector<Info>& filesTxtInfos, const std::function<void(std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug, unsigned int jobs);
+
 protected:
     static std::string getFilesTxt(const std::list<std::string> &sourcefiles, const std::list<FileSettings> &fileSettings);
 
@@ -91,8 +113,25 @@ protected:
 
     static std::string skipAnalysis(const tinyxml2::XMLDocument &analyzerInfoDoc, std::size_t hash, std::list<ErrorMessage> &errors);
 
+    /** skipAnalysis() for the binary format */
+    static std::string skipAnalysis(const std::string &analyzerInfo, std::size_t hash, std::list<ErrorMessage> &errors);
+
+    /** Call @p handler for every FileInfo in the analyzer information of @p filesTxtInfo */
+    static std::string processAnalyzerInfoFile(const std::string& buildDir, const Info& filesTxtInfo, const std::function<void(const char* checkattr, const tinyxml2::XMLElement* e, const Info& filesTxtInfo)>& handler, bool debug);
+
+    /**
+     * Load the errors from XML or binary analyzer information.
+     * @param loaded set to false if the XML could not be parsed
+     * @return the reason why the analyzer information cannot be used
+     */
+    static std::string loadAnalyzerInfo(const std::string &content, std::size_t hash, std::list<ErrorMessage> &errors, bool &loaded);
+
 private:
     std::ofstream mOutputStream;
+    bool mBinary{};
+    std::string mAnalyzerInfoFile;
+    const ResultCache* mResultCache{};
+    std::string mResultCacheKey;
 };
 
 /// @}
@@ -37,6 +37,9 @@
 #include "checkclass.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
 #include <initializer_list>
@@ -2916,6 +2919,54 @@ const Token* findEscapeStatement(const Scope* scope, const Library& library)
     return nullptr;
 }
 
+bool mayChangeExpression(const Token* tok)
+{
+    if (!tok || !tok->isMutableExpr())
+        return false;
+    // function calls might change global variables and lambdas are not traversed
+    if (Token::Match(tok, "%name% ("))
+        return true;
+    // isVariableChanged() only looks at the token and its ancestors
+    bool container = false;
+    const Token* child = nullptr;
+    for (const Token* parent = tok; parent; child = parent, parent = parent->astParent()) {
+        container = container || astIsContainer(parent);
+        // placement new
+        if (Token::simpleMatch(parent->tokAt(-2), "new ("))
+            return true;
+        // function call or constructor
+        if (Token::Match(parent, "(|{") && !parent->isCast() && Token::Match(parent->link(), ")|} !!{"))
+            return true;
+        // associative container
+        if (parent->str() == "[" && container)
+            return true;
+        if (!child)
+            continue;
+        if (parent->isIncDecOp())
+            return true;
+        if (parent->isAssignmentOp()) {
+            if (child == parent->astOperand1())
+                return true;
+            // reference or structured binding
+            if (Token::simpleMatch(parent->previous(), "]"))
+                return true;
+            const Variable* var = getLHSVariable(parent);
+            if (var && var->isReference())
+                return true;
+        }
+        // stream
+        if (Token::Match(parent, "<<|>>") || (parent->str() == "&" && parent->isBinaryOp()))
+            return true;
+        // range for loop or structured binding
+        if (parent->str() == ":" && !Token::simpleMatch(parent->astParent(), "?"))
+            return true;
+        // member function call or member pointer
+        if (parent->str() == "." && (parent->strAt(1) == "*" || isFunctionCall(parent->next())))
+            return true;
+    }
+    return false;
+}
+
 template<class F,
          REQUIRES("F must be a function that returns a Token class",
                   std::is_convertible<decltype(std::declval<F>()()), const Token*> )>
@@ -2982,6 +3033,46 @@ bool isExpressionChangedAt(const Token* expr,
     }, tok, indirect, expr->exprId(), globalvar, settings, depth);
 }
 
+/**
+ * Find the first token in [start, end) where @p pred is true. Only the tokens that might change an
+ * expression are checked if they are indexed by the symbol database.
+ */
+template<class T, class Predicate, REQUIRES("T must be a Token class", std::is_convertible<T*, const Token*> )>
+static T* findChangingToken(T* start, const Token* end, const Predicate& pred)
+{
+    std::vector<const Token*>::const_iterator first;
+    std::vector<const Token*>::const_iterator last;
+    static const bool noindex = std::getenv("NOINDEX") != nullptr;
+    if (!noindex && start->scope() && start->scope()->symdb.getChangingTokens(start, end, first, last)) {
+        static long calls = 0, visited = 0, linear = 0;
+        calls++; visited += last - first;
+        for (const Token* t = start; t && t != end; t = t->next()) linear++;
+        static double tt = 0; static int dd = 0;
+        auto t0 = std::chrono::steady_clock::now(); dd++;
+        const auto it = std::find_if(first, last, pred);
+        dd--; if (!dd) tt += std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+        if (calls % 20000 == 0) fprintf(stderr, "IDX %ld calls %ld visited %ld linear %.2fs\n", calls, visited, linear, tt);
+        T* res = it == last ? nullptr : const_cast<T*>(*it);
+        static const bool xcheck = std::getenv("XCHECK") != nullptr;
+        if (xcheck) {
+            T* ref = nullptr;
+            for (T* tok = start; tok && tok != end; tok = tok->next()) {
+                if (pred(tok)) { ref = tok; break; }
+            }
+            if (ref != res) {
+                fprintf(stderr, "XCHECK MISMATCH %s:%d %s\n", ref ? ref->str().c_str() : "null", ref ? ref->linenr() : 0, ref ? ref->expressionString().c_str() : "");
+                abort();
+            }
+        }
+        return res;
+    }
+    for (T* tok = start; tok && tok != end; tok = tok->next()) {
+        if (pred(tok))
+            return tok;
+    }
+    return nullptr;
+}
+
 Token* findVariableChanged(Token *start, const Token *end, int indirect, const nonneg int exprid, bool globalvar, const Settings &settings, int depth)
 {
     if (!precedes(start, end))
@@ -2991,11 +3082,9 @@ Token* findVariableChanged(Token *start, const Token *end, int indirect, const n
     auto getExprTok = utils::memoize([&] {
         return findExpression(start, exprid);
     });
-    for (Token *tok = start; tok != end; tok = tok->next()) {
-        if (isExpressionChangedAt(getExprTok, tok, indirect, exprid, globalvar, settings, depth))
-            return tok;
-    }
-    return nullptr;
+    return findChangingToken(start, end, [&](const Token* tok) {
+        return isExpressionChangedAt(getExprTok, tok, indirect, exprid, globalvar, settings, depth);
+    });
 }
 
 const Token* findVariableChanged(const Token *start, const Token *end, int indirect, const nonneg int exprid, bool globalvar, const Settings &settings, int depth)
@@ -3134,7 +3223,7 @@ namespace {
         template<class F>
         const Token* operator()(const Token* start, const Token* end, F f) const
         {
-            return findToken(start, end, f);
+            return findChangingToken(start, end, f);
         }
     };
 
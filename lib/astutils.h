@@ -374,12 +374,19 @@ const Token* findExpressionChangedSkipDeadCode(const Token* expr,
                                                const std::function<std::vector<MathLib::bigint>(const Token* tok)>& evaluate,
                                                int depth = 20);
 
-bool isExpressionChangedAt(const Token* expr,
-                           const Token* tok,
-                           int indirect,
-                           bool globalvar,
-                           const Settings& settings,
-                           int depth = 20);
+CPPCHECKLIB bool isExpressionChangedAt(const Token* expr,
+                                       const Token* tok,
+                                       int indirect,
+                                       bool globalvar,
+                                       const Settings& settings,
+                                       int depth = 20);
+
+/**
+ * Might an expression be changed at @p tok?
+ * This is a cheap superset of isExpressionChangedAt() that only depends on the AST and the value
+ * types, so it is the same for all expressions and does not change during the analysis.
+ */
+CPPCHECKLIB bool mayChangeExpression(const Token* tok);
 
 /// If token is an alias if another variable
 bool isAliasOf(const Token *tok, nonneg int varid, bool* inconclusive = nullptr);
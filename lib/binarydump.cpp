@@ -0,0 +1,311 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "binarydump.h"
+
+#include <cstdlib>
+
+static const char binaryDumpMagic[8] = {'C', 'P', 'P', 'C', 'H', 'K', 'D', 'U'};
+static constexpr std::uint32_t binaryDumpVersion = 1;
+
+/** flush the encoded data to the stream when this size is exceeded */
+static constexpr std::size_t outputBufferSize = 64 * 1024;
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+BinaryDumpEncoder::BinaryDumpEncoder(std::ostream &out)
+    : mOut(out)
+{
+    mOutput.append(binaryDumpMagic, sizeof(binaryDumpMagic));
+    for (int i = 0; i < 4; ++i)
+        mOutput += static_cast<char>((binaryDumpVersion >> (8 * i)) & 0xff);
+}
+
+BinaryDumpEncoder::~BinaryDumpEncoder()
+{
+    finish();
+}
+
+void BinaryDumpEncoder::finish()
+{
+    if (mFinished)
+        return;
+    mFinished = true;
+
+    const std::uint64_t indexOffset = mOffset + mOutput.size();
+    mOutput += 'I';
+    writeVarint(mShapes.size());
+    for (const auto &shape : mShapes) {
+        writeString(shape.first);
+        writeVarint(shape.second.size());
+        for (const std::string &attrName : shape.second)
+            writeString(attrName);
+    }
+    writeVarint(mSections.size());
+    for (const auto &section : mSections) {
+        writeString(section.first);
+        writeVarint(section.second);
+    }
+    for (int i = 0; i < 8; ++i)
+        mOutput += static_cast<char>((indexOffset >> (8 * i)) & 0xff);
+    flushOutput();
+    mOut.flush();
+}
+
+BinaryDumpEncoder::int_type BinaryDumpEncoder::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+    if (mFinished)
+        return traits_type::eof();
+    encode(traits_type::to_char_type(c));
+    return c;
+}
+
+std::streamsize BinaryDumpEncoder::xsputn(const char *s, std::streamsize n)
+{
+    if (mFinished)
+        return 0;
+    for (std::streamsize i = 0; i < n; ++i)
+        encode(s[i]);
+    return n;
+}
+
+int BinaryDumpEncoder::sync()
+{
+    flushOutput();
+    mOut.flush();
+    return mOut ? 0 : -1;
+}
+
+void BinaryDumpEncoder::encode(char c)
+{
+    switch (mState) {
+    case State::Text:
+        // there is no text content in the dump
+        if (c == '<')
+            mState = State::Open;
+        break;
+    case State::Open:
+        if (c == '?' || c == '!') {
+            // xml declaration or comment
+            mState = State::Skip;
+        } else if (c == '/') {
+            mState = State::Close;
+        } else {
+            mName.assign(1, c);
+            mState = State::Name;
+        }
+        break;
+    case State::Skip:
+        if (c == '>')
+            mState = State::Text;
+        break;
+    case State::Close:
+        if (c == '>') {
+            mOutput += 'E';
+            if (mDepth > 0)
+                --mDepth;
+            mState = State::Text;
+        }
+        break;
+    case State::Name:
+        if (isSpace(c))
+            mState = State::Tag;
+        else if (c == '/')
+            mState = State::EmptyTag;
+        else if (c == '>')
+            emitElement(true);
+        else
+            mName += c;
+        break;
+    case State::Tag:
+        if (c == '/')
+            mState = State::EmptyTag;
+        else if (c == '>')
+            emitElement(true);
+        else if (!isSpace(c)) {
+            mAttrNames.emplace_back(1, c);
+            mState = State::AttrName;
+        }
+        break;
+    case State::EmptyTag:
+        if (c == '>')
+            emitElement(false);
+        break;
+    case State::AttrName:
+        if (c == '=')
+            mState = State::AttrValueStart;
+        else if (!isSpace(c))
+            mAttrNames.back() += c;
+        break;
+    case State::AttrValueStart:
+        if (c == '\"' || c == '\'') {
+            mQuote = c;
+            if (mAttrNames.size() > 1)
+                mValues += '\0';
+            mState = State::AttrValue;
+        }
+        break;
+    case State::AttrValue:
+        if (c == mQuote) {
+            mState = State::Tag;
+        } else if (c == '&') {
+            mEntity.clear();
+            mState = State::Entity;
+        } else {
+            mValues += c;
+        }
+        break;
+    case State::Entity:
+        if (c == ';') {
+            encodeEntity();
+            mState = State::AttrValue;
+        } else {
+            mEntity += c;
+        }
+        break;
+    }
+}
+
+void BinaryDumpEncoder::encodeEntity()
+{
+    if (mEntity == "lt")
+        mValues += '<';
+    else if (mEntity == "gt")
+        mValues += '>';
+    else if (mEntity == "amp")
+        mValues += '&';
+    else if (mEntity == "quot")
+        mValues += '\"';
+    else if (mEntity == "apos")
+        mValues += '\'';
+    else if (mEntity.size() > 1 && mEntity[0] == '#') {
+        const bool hex = (mEntity[1] == 'x' || mEntity[1] == 'X');
+        const unsigned long code = std::strtoul(mEntity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10);
+        if (code < 0x80) {
+            mValues += static_cast<char>(code);
+        } else if (code < 0x800) {
+            mValues += static_cast<char>(0xc0 | (code >> 6));
+            mValues += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+            mValues += static_cast<char>(0xe0 | (code >> 12));
+            mValues += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            mValues += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+            mValues += static_cast<char>(0xf0 | ((code >> 18) & 0x07));
+            mValues += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            mValues += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            mValues += static_cast<char>(0x80 | (code & 0x3f));
+        }
+    } else {
+        // unknown entity - keep it as it is
+        mValues += '&' + mEntity + ';';
+    }
+}
+
+void BinaryDumpEncoder::emitElement(bool hasChildren)
+{
+    std::string key = mName;
+    for (const std::string &attrName : mAttrNames) {
+        key += '\0';
+        key += attrName;
+    }
+    const auto it = mShapeIds.emplace(std::move(key), mShapes.size());
+    if (it.second)
+        mShapes.emplace_back(mName, mAttrNames);
+
+    if (mDepth == 1)
+        mSections.emplace_back(mName, mOffset + mOutput.size());
+
+    mOutput += hasChildren ? 'S' : 'L';
+    writeVarint(it.first->second);
+    writeVarint(mValues.size());
+    mOutput += mValues;
+    if (hasChildren)
+        ++mDepth;
+
+    mName.clear();
+    mAttrNames.clear();
+    mValues.clear();
+    mState = State::Text;
+
+    if (mOutput.size() > outputBufferSize)
+        flushOutput();
+}
+
+void BinaryDumpEncoder::writeVarint(std::uint64_t value)
+{
+    while (value >= 0x80) {
+        mOutput += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    mOutput += static_cast<char>(value);
+}
+
+void BinaryDumpEncoder::writeString(const std::string &s)
+{
+    writeVarint(s.size());
+    mOutput += s;
+}
+
+void BinaryDumpEncoder::flushOutput()
+{
+    mOut.write(mOutput.data(), static_cast<std::streamsize>(mOutput.size()));
+    mOffset += mOutput.size();
+    mOutput.clear();
+}
+
+DumpFile::DumpFile()
+    : std::ostream(nullptr)
+{}
+
+DumpFile::~DumpFile()
+{
+    close();
+}
+
+bool DumpFile::open(const std::string &filename, bool binary)
+{
+    mFile.open(filename, binary ? (std::ios::out | std::ios::binary) : std::ios::out);
+    if (!mFile.is_open())
+        return false;
+    if (binary) {
+        mEncoder.reset(new BinaryDumpEncoder(mFile));
+        rdbuf(mEncoder.get());
+    } else {
+        rdbuf(mFile.rdbuf());
+    }
+    clear();
+    return true;
+}
+
+void DumpFile::close()
+{
+    if (!mFile.is_open())
+        return;
+    if (mEncoder)
+        mEncoder->finish();
+    flush();
+    rdbuf(nullptr);
+    mEncoder.reset();
+    mFile.close();
+}
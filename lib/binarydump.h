@@ -0,0 +1,140 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef binarydumpH
+#define binarydumpH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Encoder for the binary dump format (--dump-format=binary)
+ *
+ * The dump is written as XML to this stream buffer and is encoded on the fly into
+ * the same tree of elements and attributes, without the markup and the repeated
+ * attribute names:
+ *
+ *   header:  magic "CPPCHKDU", version (u32)
+ *   record:  'S' shape, size, values - element with children, followed by the children and 'E'
+ *            'L' shape, size, values - element without children
+ *            'E' end of the element
+ *   trailer: 'I' shape count, per shape: tag, attribute count, attribute names
+ *                section count, per child of the root element: tag, offset of its record
+ *            offset of the 'I' record (u64)
+ *
+ * A shape is a tag together with the names of its attributes. The values of the
+ * attributes are separated by '\0'. Sizes, counts, shapes and offsets are stored as
+ * variable length integers (7 bits per byte, least significant first), strings as size
+ * and characters and the fixed size integers in little endian byte order. The trailer
+ * allows readers to load single sections of the dump. addons/cppcheckdata.py reads
+ * both formats.
+ */
+class CPPCHECKLIB BinaryDumpEncoder : public std::streambuf {
+public:
+    explicit BinaryDumpEncoder(std::ostream &out);
+    ~BinaryDumpEncoder() override;
+
+    BinaryDumpEncoder(const BinaryDumpEncoder &) = delete;
+    BinaryDumpEncoder &operator=(const BinaryDumpEncoder &) = delete;
+
+    /** Encode the remaining XML and write the trailer. Nothing can be written afterwards. */
+    void finish();
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+    int sync() override;
+
+private:
+    enum class State : std::uint8_t {
+        Text, Open, Skip, Close, Name, Tag, EmptyTag, AttrName, AttrValueStart, AttrValue, Entity
+    };
+
+    void encode(char c);
+    void encodeEntity();
+    void emitElement(bool hasChildren);
+    void writeVarint(std::uint64_t value);
+    void writeString(const std::string &s);
+    void flushOutput();
+
+    std::ostream &mOut;
+    bool mFinished{};
+
+    State mState{State::Text};
+    /** quote character of the current attribute value */
+    char mQuote{};
+    std::string mName;
+    std::vector<std::string> mAttrNames;
+    std::string mValues;
+    std::string mEntity;
+    std::size_t mDepth{};
+
+    /** shape id by tag and attribute names */
+    std::unordered_map<std::string, std::size_t> mShapeIds;
+    std::vector<std::pair<std::string, std::vector<std::string>>> mShapes;
+    /** tag and offset of the children of the root element */
+    std::vector<std::pair<std::string, std::uint64_t>> mSections;
+
+    std::string mOutput;
+    std::uint64_t mOffset{};
+};
+
+/**
+ * @brief Output stream for a dump file. The XML written to it is encoded when the
+ * binary format is used.
+ */
+class CPPCHECKLIB DumpFile : public std::ostream {
+public:
+    DumpFile();
+    ~DumpFile() override;
+
+    DumpFile(const DumpFile &) = delete;
+    DumpFile &operator=(const DumpFile &) = delete;
+
+    /** @return false if the file could not be created */
+    bool open(const std::string &filename, bool binary);
+
+    bool is_open() const {
+        return mFile.is_open();
+    }
+
+    void close();
+
+private:
+    std::ofstream mFile;
+    std::unique_ptr<BinaryDumpEncoder> mEncoder;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // binarydumpH
@@ -64,7 +64,7 @@ static const CWE CWE_BUFFER_OVERRUN(788U);   // Access of Memory Location After
 
 static const ValueFlow::Value *getBufferSizeValue(const Token *tok)
 {
-    const std::list<ValueFlow::Value> &tokenValues = tok->values();
+    const std::vector<ValueFlow::Value> &tokenValues = tok->values();
     auto it = std::find_if(tokenValues.cbegin(), tokenValues.cend(), std::mem_fn(&ValueFlow::Value::isBufferSizeValue));
     if (it != tokenValues.cend())
         return &*it;
@@ -822,7 +822,7 @@ void CheckBufferOverrunImpl::stringNotZeroTerminated()
             if (bufferSize.intvalue < 0 || sizeToken->getKnownIntValue() < bufferSize.intvalue)
                 continue;
             if (Token::simpleMatch(args[1], "(") && Token::simpleMatch(args[1]->astOperand1(), ". c_str") && args[1]->astOperand1()->astOperand1()) {
-                const std::list<ValueFlow::Value>& contValues = args[1]->astOperand1()->astOperand1()->values();
+                const std::vector<ValueFlow::Value>& contValues = args[1]->astOperand1()->astOperand1()->values();
                 auto it = std::find_if(contValues.cbegin(), contValues.cend(), [](const ValueFlow::Value& value) {
                     return value.isContainerSizeValue() && !value.isImpossible();
                 });
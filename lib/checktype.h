@@ -26,8 +26,8 @@
 #include "checkimpl.h"
 #include "config.h"
 
-#include <list>
 #include <string>
+#include <vector>
 
 class ErrorLogger;
 class Settings;
@@ -87,7 +87,7 @@ public:
 
     /** @brief %Check for float to integer overflow */
     void checkFloatToIntegerOverflow();
-    void checkFloatToIntegerOverflow(const Token *tok, const ValueType *vtint, const ValueType *vtfloat, const std::list<ValueFlow::Value> &floatValues);
+    void checkFloatToIntegerOverflow(const Token *tok, const ValueType *vtint, const ValueType *vtfloat, const std::vector<ValueFlow::Value> &floatValues);
 
     // Error messages..
     void tooBigBitwiseShiftError(const Token *tok, int lhsbits, const ValueFlow::Value &rhsbits);
@@ -453,24 +453,39 @@ namespace {
         nonneg int lineNumber;
         nonneg int column;
     };
+
+    /** The functions from the analyzer information of a single file */
+    struct FunctionsShard {
+        std::map<std::string, Location> decls;
+        std::set<std::string> calls;
+    };
 }
 
 // TODO: bail out on unexpected data
 void CheckUnusedFunctions::analyseWholeProgram(const Settings &settings, ErrorLogger &errorLogger, const std::string &buildDir)
 {
-    std::map<std::string, Location> decls;
-    std::set<std::string> calls;
+    std::vector<AnalyzerInformation::Info> filesTxtInfos;
+    std::string err = AnalyzerInformation::readFilesTxt(buildDir, filesTxtInfos);
+    if (!err.empty()) {
+        const ErrorMessage errmsg({}, "", Severity::error, err, "internalError", Certainty::normal);
+        errorLogger.reportErr(errmsg);
+        return;
+    }
 
-    const auto handler = [&decls, &calls](const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
+    // the files are loaded in parallel into a shard per file which are merged in the order of files.txt
+    std::vector<FunctionsShard> shards(filesTxtInfos.size());
+
+    const auto handler = [&shards](std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
         if (std::strcmp(checkattr,"CheckUnusedFunctions") != 0)
             return;
+        FunctionsShard &shard = shards[fileIndex];
         for (const tinyxml2::XMLElement *e2 = e->FirstChildElement(); e2; e2 = e2->NextSiblingElement()) {
             const char* functionName = e2->Attribute("functionName");
             if (functionName == nullptr)
                 continue;
             const char* name = e2->Name();
             if (std::strcmp(name,"functioncall") == 0) {
-                calls.insert(functionName);
+                shard.calls.insert(functionName);
                 continue;
             }
             if (std::strcmp(name,"functiondecl") == 0) {
@@ -479,19 +494,28 @@ void CheckUnusedFunctions::analyseWholeProgram(const Settings &settings, ErrorLo
                     const char* file = e2->Attribute("file");
                     const char* column = default_if_null(e2->Attribute("column"), "0");
                     // cppcheck-suppress templateInstantiation - TODO: fix this - see #11631
-                    decls[functionName] = Location(file ? file : filesTxtInfo.sourceFile, strToInt<int>(lineNumber), strToInt<int>(column));
+                    shard.decls[functionName] = Location(file ? file : filesTxtInfo.sourceFile, strToInt<int>(lineNumber), strToInt<int>(column));
                 }
             }
         }
     };
 
-    const std::string err = AnalyzerInformation::processFilesTxt(buildDir, handler, settings.debugainfo);
+    err = AnalyzerInformation::processFilesTxt(buildDir, filesTxtInfos, handler, settings.debugainfo, settings.jobs);
     if (!err.empty()) {
         const ErrorMessage errmsg({}, "", Severity::error, err, "internalError", Certainty::normal);
         errorLogger.reportErr(errmsg);
         return;
     }
 
+    std::map<std::string, Location> decls;
+    std::set<std::string> calls;
+    for (FunctionsShard &shard : shards) {
+        // a later declaration overrides an earlier one
+        for (auto &decl : shard.decls)
+            decls[decl.first] = std::move(decl.second);
+        calls.insert(shard.calls.cbegin(), shard.calls.cend());
+    }
+
     for (auto decl = decls.cbegin(); decl != decls.cend(); ++decl) {
         const std::string &functionName = stripTemplateParameters(decl->first);
 
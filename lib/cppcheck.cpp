@@ -20,6 +20,7 @@
 
 #include "addoninfo.h"
 #include "analyzerinfo.h"
+#include "binarydump.h"
 #include "check.h"
 #include "checks.h"
 #include "checkunusedfunctions.h"
@@ -30,9 +31,11 @@
 #include "errortypes.h"
 #include "filesettings.h"
 #include "library.h"
+#include "parallel.h"
 #include "path.h"
 #include "platform.h"
 #include "preprocessor.h"
+#include "resultcache.h"
 #include "settings.h"
 #include "standards.h"
 #include "suppressions.h"
@@ -60,8 +63,10 @@
 #include <ctime>
 #include <exception> // IWYU pragma: keep
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <list>
 #include <map>
 #include <new>
 #include <set>
@@ -106,13 +111,27 @@ public:
         mRemarkComments.insert(mRemarkComments.end(), remarkComments.begin(), remarkComments.end());
     }
 
-    void setLocationMacros(const Token* startTok, const std::vector<std::string>& files)
+    using Location = std::pair<std::string, int>;
+    using LocationMacros = std::map<Location, std::set<std::string>>;
+
+    static LocationMacros getLocationMacros(const Token* startTok, const std::vector<std::string>& files)
     {
-        mLocationMacros.clear();
+        LocationMacros locationMacros;
         for (const Token* tok = startTok; tok; tok = tok->next()) {
             if (!tok->getMacroName().empty())
-                mLocationMacros[Location(files[tok->fileIndex()], tok->linenr())].emplace(tok->getMacroName());
+                locationMacros[Location(files[tok->fileIndex()], tok->linenr())].emplace(tok->getMacroName());
         }
+        return locationMacros;
+    }
+
+    void setLocationMacros(const Token* startTok, const std::vector<std::string>& files)
+    {
+        mLocationMacros = getLocationMacros(startTok, files);
+    }
+
+    void setLocationMacros(LocationMacros locationMacros)
+    {
+        mLocationMacros = std::move(locationMacros);
     }
 
     void resetExitCode()
@@ -287,8 +306,7 @@ private:
 
     std::vector<RemarkComment> mRemarkComments;
 
-    using Location = std::pair<std::string, int>;
-    std::map<Location, std::set<std::string>> mLocationMacros; // What macros are used on a location?
+    LocationMacros mLocationMacros; // What macros are used on a location?
 
     std::ofstream mPlistFile;
     std::vector<std::string> mPlistFilenames;
@@ -299,6 +317,69 @@ private:
 };
 
 
+namespace {
+    /** The whole program analysis information loaded from a single analyzer information file */
+    struct WholeProgramShard
+    {
+        CTU::FileInfo ctu;
+        std::list<const Check::FileInfo*> fileInfo;
+    };
+}
+
+/** Call "analyseWholeProgram" in all registered Check classes */
+static bool analyseWholeProgramChecks(const CTU::FileInfo &ctu, const std::list<const Check::FileInfo*> &fileInfo, const Settings &settings, ErrorLogger &errorLogger)
+{
+    if (settings.jobs <= 1) {
+        bool errors = false;
+        for (Check * const c : CheckInstances::get())
+            errors |= c->analyseWholeProgram(ctu, fileInfo, settings, errorLogger);
+        return errors;
+    }
+
+    // the checks are analysed in parallel, the results are buffered per check and forwarded in the
+    // order of the registered checks so the output matches the serial execution
+    const std::vector<Check *> checks(CheckInstances::get().cbegin(), CheckInstances::get().cend());
+    std::vector<BufferedErrorLogger> buffers(checks.size());
+    std::vector<char> errors(checks.size(), 0);
+
+    const std::vector<std::exception_ptr> exceptions = executeParallel(checks.size(), settings.jobs, [&](std::size_t i) {
+        errors[i] = checks[i]->analyseWholeProgram(ctu, fileInfo, settings, buffers[i]);
+    });
+
+    bool ret = false;
+    for (std::size_t i = 0; i < checks.size(); ++i) {
+        buffers[i].forward(errorLogger);
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        ret |= errors[i] != 0;
+    }
+    return ret;
+}
+
+/** A preprocessed configuration that is checked concurrently with the other configurations of the file */
+struct CppCheck::ConfigurationToCheck
+{
+    ConfigurationToCheck(std::string currentConfig, TokenList tokenlist, std::string preprocessorDump, bool reportChecking)
+        : currentConfig(std::move(currentConfig))
+        , tokenlist(std::move(tokenlist))
+        , preprocessorDump(std::move(preprocessorDump))
+        , reportChecking(reportChecking)
+    {}
+
+    std::string currentConfig;
+    TokenList tokenlist;
+    std::string preprocessorDump;
+    bool reportChecking;
+
+    std::unique_ptr<Tokenizer> tokenizer;
+    BufferedErrorLogger errorLogger;
+    CppCheckLogger::LocationMacros locationMacros;
+    std::string dump;
+    bool simplified{};
+    bool purged{};
+    bool checked{};
+};
+
 // File deleter
 namespace {
     class FilesDeleter {
@@ -347,6 +428,16 @@ static std::vector<std::string> split(const std::string &str, const std::string
     return ret;
 }
 
+static void reportMemstats(ErrorLogger &errorLogger, const std::string &file, const std::string &cfg, const TokenList &tokenlist)
+{
+    const TokenList::ValueStats stats = tokenlist.valueStats();
+    std::string msg = "Memory: " + file;
+    if (!cfg.empty())
+        msg += ": " + cfg;
+    msg += ": " + std::to_string(stats.values) + " values, " + std::to_string(stats.bytes) + " bytes";
+    errorLogger.reportOut(msg, Color::Reset);
+}
+
 static std::string getDumpFileName(const Settings& settings, const FileWithDetails& file)
 {
     std::string extension = ".dump";
@@ -367,15 +458,14 @@ static std::string getCtuInfoFileName(const std::string &dumpFile)
 
 static void createDumpFile(const Settings& settings,
                            const FileWithDetails& file,
-                           std::ofstream& fdump,
+                           DumpFile& fdump,
                            std::string& dumpFile)
 {
     if (!settings.dump && settings.addons.empty())
         return;
     dumpFile = getDumpFileName(settings, file);
 
-    fdump.open(dumpFile);
-    if (!fdump.is_open())
+    if (!fdump.open(dumpFile, settings.dumpFormat == Settings::DumpFormat::binary))
         return;
 
     if (!settings.buildDir.empty()) {
@@ -446,7 +536,8 @@ static std::vector<picojson::value> executeAddon(const AddonInfo &addonInfo,
                                                  const std::string &defaultPythonExe,
                                                  const std::string &file,
                                                  const std::string &premiumArgs,
-                                                 const CppCheck::ExecuteCmdFn &executeCommand)
+                                                 const CppCheck::ExecuteCmdFn &executeCommand,
+                                                 const CppCheck::ExecuteAddonFn &executeAddonServer)
 {
     if (!executeCommand)
         throw InternalError(nullptr, "Failed to execute addon - no command callback provided");
@@ -479,7 +570,19 @@ static std::vector<picojson::value> executeAddon(const AddonInfo &addonInfo,
     args += fileArg;
 
     std::string result;
-    if (const int exitcode = executeCommand(pythonExe, split(args), "2>&1", result)) {
+    int exitcode = 0;
+    bool executed = false;
+    if (executeAddonServer && addonInfo.executable.empty()) {
+        // the server is started once with the script and receives the arguments for every file
+        std::string serverExe = pythonExe;
+        if (serverExe.size() >= 2 && serverExe.front() == '\"' && serverExe.back() == '\"')
+            serverExe = serverExe.substr(1, serverExe.size() - 2);
+        const std::vector<std::string> serverArgs = split(cmdFileName(addonInfo.runScript) + " " + cmdFileName(addonInfo.scriptFile) + " --server");
+        executed = executeAddonServer(serverExe, serverArgs, split("--cli" + addonInfo.args + fileArg), result, exitcode);
+    }
+    if (!executed)
+        exitcode = executeCommand(pythonExe, split(args), "2>&1", result);
+    if (exitcode) {
         std::string message("Failed to execute addon '" + addonInfo.name + "' - exitcode is " + std::to_string(exitcode));
         std::string details = pythonExe + " " + args;
         if (result.size() > 2) {
@@ -545,6 +648,15 @@ static std::string getDefinesFlags(const std::string &semicolonSeparatedString)
     return flags;
 }
 
+static std::string createLibraryDumpData(const Settings& settings)
+{
+    std::string out;
+    for (const std::string &s : settings.libraries) {
+        out += "  <library lib=\"" + s + "\"/>\n";
+    }
+    return out;
+}
+
 CppCheck::CppCheck(const Settings& settings,
                    Suppressions& supprs,
                    ErrorLogger &errorLogger,
@@ -559,6 +671,7 @@ CppCheck::CppCheck(const Settings& settings,
     , mTimerResults(timerResults)
     , mUseGlobalSuppressions(useGlobalSuppressions)
     , mExecuteCommand(std::move(executeCommand))
+    , mLibraryDumpData(createLibraryDumpData(settings))
 {}
 
 CppCheck::~CppCheck()
@@ -631,13 +744,6 @@ static bool reportClangErrors(std::istream &is, const std::function<void(const E
     return false;
 }
 
-std::string CppCheck::getLibraryDumpData() const {
-    std::string out;
-    for (const std::string &s : mSettings.libraries) {
-        out += "  <library lib=\"" + s + "\"/>\n";
-    }
-    return out;
-}
 
 /**
  * @brief Get the clang command line flags using the Settings
@@ -761,7 +867,7 @@ unsigned int CppCheck::checkClang(const FileWithDetails &file)
         checkNormalTokens(tokenizer, nullptr, ""); // TODO: provide analyzer information
 
         // create dumpfile
-        std::ofstream fdump;
+        DumpFile fdump;
         std::string dumpFile;
         createDumpFile(mSettings, file, fdump, dumpFile);
         if (fdump.is_open()) {
@@ -847,6 +953,7 @@ unsigned int CppCheck::check(const FileSettings &fs)
         tempSettings.includePaths.insert(tempSettings.includePaths.end(), fs.systemIncludePaths.cbegin(), fs.systemIncludePaths.cend());
         // need to pass the externally provided ErrorLogger instead of our internal wrapper
         CppCheck temp(tempSettings, mSuppressions, mErrorLoggerDirect, mTimerResults, mUseGlobalSuppressions, mExecuteCommand);
+        temp.setExecuteAddon(mExecuteAddon);
         // TODO: propagate back mFileInfo
         const unsigned int returnValue = temp.check(fs.file);
         if (mUnusedFunctionsCheck)
@@ -855,6 +962,7 @@ unsigned int CppCheck::check(const FileSettings &fs)
     }
     // need to pass the externally provided ErrorLogger instead of our internal wrapper
     CppCheck temp(tempSettings, mSuppressions, mErrorLoggerDirect, mTimerResults, mUseGlobalSuppressions, mExecuteCommand);
+    temp.setExecuteAddon(mExecuteAddon);
     const unsigned int returnValue = temp.checkFile(fs.file, fs.cfg);
     if (mUnusedFunctionsCheck)
         mUnusedFunctionsCheck->updateFunctionData(*temp.mUnusedFunctionsCheck);
@@ -887,6 +995,10 @@ std::size_t CppCheck::calculateHash(const Preprocessor& preprocessor, const std:
         toolinfo << a.args;
     }
     toolinfo << mSettings.premiumArgs;
+    for (const std::string &lib : mSettings.libraries)
+        toolinfo << lib;
+    toolinfo << mSettings.platform.toString();
+    toolinfo << mSettings.standards.getC() << mSettings.standards.getCPP();
     // TODO: do we need to add more options?
     mSuppressions.nomsg.dump(toolinfo, filePath);
     return preprocessor.calculateHash(toolinfo.str());
@@ -963,6 +1075,10 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
 
     mLogger->closePlist();
 
+    std::unique_ptr<ResultCache> resultCache;
+    if (!mSettings.buildDir.empty() && !mSettings.cacheDir.empty())
+        resultCache.reset(new ResultCache(mSettings.cacheDir));
+
     std::unique_ptr<AnalyzerInformation> analyzerInformation;
 
     try {
@@ -970,7 +1086,7 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
             // TODO: if an exception occurs in this block it will continue in an unexpected code path
             if (!mSettings.buildDir.empty())
             {
-                analyzerInformation.reset(new AnalyzerInformation);
+                analyzerInformation.reset(new AnalyzerInformation(mSettings.analyzerInfoFormat == Settings::AnalyzerInfoFormat::binary));
                 mLogger->setAnalyzerInfo(analyzerInformation.get());
             }
 
@@ -1012,9 +1128,12 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
 
         checkPlistOutput(file);
 
-        std::string dumpFooter;
+        // the raw tokens are modified below so their dump is created now and written at the end
+        std::string dumpRawTokens;
         if (mSettings.dump || !mSettings.addons.empty()) {
-            dumpFooter += getDumpFileContentsRawTokensFooter(tokens1);
+            Timer::run("CppCheck::dump", mTimerResults, [&]() {
+                dumpRawTokens = getDumpFileContentsRawTokensFooter(tokens1);
+            });
         }
 
         // Parse comments and then remove them
@@ -1023,7 +1142,8 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
         preprocessor.removeComments();
 
         if (!mSettings.buildDir.empty()) {
-            analyzerInformation.reset(new AnalyzerInformation);
+            analyzerInformation.reset(new AnalyzerInformation(mSettings.analyzerInfoFormat == Settings::AnalyzerInfoFormat::binary));
+            analyzerInformation->setResultCache(resultCache.get());
             mLogger->setAnalyzerInfo(analyzerInformation.get());
         }
 
@@ -1105,14 +1225,14 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
             }
             TokenList tokenlist(mSettings, file.lang());
             tokenlist.createTokensFromBuffer(code.data(), code.size()); // TODO: check result?
-            executeRules("define", tokenlist);
+            executeRules("define", tokenlist, mErrorLogger);
         }
 #endif
 
         FilesDeleter filesDeleter;
 
         // write dump file xml prolog
-        std::ofstream fdump;
+        DumpFile fdump;
         std::string dumpFile;
         createDumpFile(mSettings, file, fdump, dumpFile);
         if (fdump.is_open()) {
@@ -1122,6 +1242,7 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
         }
 
         std::set<unsigned long long> hashes;
+        std::vector<ConfigurationToCheck> configurationsToCheck;
         int checkCount = 0;
         bool hasValidConfig = false;
         std::list<std::string> configurationError;
@@ -1200,6 +1321,20 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
             }
             hasValidConfig = true;
 
+            const bool reportChecking = !mSettings.quiet && (!currentConfig.empty() || checkCount > 1);
+
+            if (mSettings.configJobs > 1) {
+                // the preprocessor output is collected now, the configuration is checked after all configurations have been preprocessed
+                std::string preprocessorDump;
+                if ((mSettings.dump || !mSettings.addons.empty()) && fdump.is_open()) {
+                    std::ostringstream oss;
+                    preprocessor.dump(oss);
+                    preprocessorDump = oss.str();
+                }
+                configurationsToCheck.emplace_back(currentConfig, std::move(tokenlist), std::move(preprocessorDump), reportChecking);
+                continue;
+            }
+
             Tokenizer tokenizer(std::move(tokenlist), mErrorLogger);
             try {
                 tokenizer.setTimerResults(mTimerResults);
@@ -1209,7 +1344,7 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
                 mLogger->setLocationMacros(tokenizer.tokens(), files);
 
                 // If only errors are printed, print filename after the check
-                if (!mSettings.quiet && (!currentConfig.empty() || checkCount > 1)) {
+                if (reportChecking) {
                     std::string fixedpath = Path::toNativeSeparators(file.spath());
                     mErrorLogger.reportOut("Checking " + fixedpath + ": " + currentConfig + "...", Color::FgGreen);
                 }
@@ -1223,24 +1358,29 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
 
 #ifdef HAVE_RULES
                 // Execute rules for "raw" code
-                executeRules("raw", tokenizer.list);
+                executeRules("raw", tokenizer.list, mErrorLogger);
 #endif
 
                 // Simplify tokens into normal form, skip rest of iteration if failed
                 if (!tokenizer.simplifyTokens1(currentConfig, file.fsFileId()))
                     continue;
 
+                if (mSettings.memstats)
+                    reportMemstats(mErrorLogger, Path::toNativeSeparators(file.spath()), currentConfig, tokenizer.list);
+
                 // dump xml if --dump
                 if ((mSettings.dump || !mSettings.addons.empty()) && fdump.is_open()) {
-                    fdump << "<dump cfg=\"" << ErrorLogger::toxml(currentConfig) << "\">" << std::endl;
-                    fdump << "  <standards>" << std::endl;
-                    fdump << "    <c version=\"" << mSettings.standards.getC() << "\"/>" << std::endl;
-                    fdump << "    <cpp version=\"" << mSettings.standards.getCPP() << "\"/>" << std::endl;
-                    fdump << "  </standards>" << std::endl;
-                    fdump << getLibraryDumpData();
-                    preprocessor.dump(fdump);
-                    tokenizer.dump(fdump);
-                    fdump << "</dump>" << std::endl;
+                    Timer::run("CppCheck::dump", mTimerResults, [&]() {
+                        fdump << "<dump cfg=\"" << ErrorLogger::toxml(currentConfig) << "\">\n";
+                        fdump << "  <standards>\n";
+                        fdump << "    <c version=\"" << mSettings.standards.getC() << "\"/>\n";
+                        fdump << "    <cpp version=\"" << mSettings.standards.getCPP() << "\"/>\n";
+                        fdump << "  </standards>\n";
+                        fdump << getLibraryDumpData();
+                        preprocessor.dump(fdump);
+                        tokenizer.dump(fdump);
+                        fdump << "</dump>\n";
+                    });
                 }
 
                 if (mSettings.inlineSuppressions) {
@@ -1267,6 +1407,9 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
             }
         }
 
+        if (!configurationsToCheck.empty())
+            checkConfigurations(file, files, directives, configurationsToCheck, analyzerInformation.get(), fdump);
+
         if (!hasValidConfig && configurations.size() > 1 && mSettings.severity.isEnabled(Severity::information)) {
             std::string msg;
             msg = "This file is not analyzed. No working configuration could be extracted. Use -v for more details.";
@@ -1287,13 +1430,14 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
 
         // TODO: will not be closed if we encountered an exception
         if (fdump.is_open()) {
-            // dump all filenames, raw tokens, suppressions
-            std::string dumpHeader = getDumpFileContentsRawTokensHeader(files);
-            fdump << getDumpFileContentsRawTokens(dumpHeader, dumpFooter);
-            mSuppressions.nomsg.dump(fdump);
-            // dumped all configs, close root </dumps> element now
-            fdump << "</dumps>" << std::endl;
-            fdump.close();
+            Timer::run("CppCheck::dump", mTimerResults, [&]() {
+                // dump all filenames, raw tokens, suppressions
+                writeDumpFileContentsRawTokens(fdump, files, dumpRawTokens);
+                mSuppressions.nomsg.dump(fdump);
+                // dumped all configs, close root </dumps> element now
+                fdump << "</dumps>\n";
+                fdump.close();
+            });
         }
 
         if (!mSettings.plistOutput.empty()) {
@@ -1301,6 +1445,10 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
         }
 
         executeAddons(dumpFile, file);
+
+        // only complete results are shared
+        if (analyzerInformation)
+            analyzerInformation->storeInResultCache();
     } catch (const TerminateException &) {
         // Analysis is terminated
         if (analyzerInformation)
@@ -1333,6 +1481,136 @@ unsigned int CppCheck::checkInternal(const FileWithDetails& file, const std::str
     return mLogger->exitcode();
 }
 
+void CppCheck::checkConfigurations(const FileWithDetails& file, const std::vector<std::string>& files, const std::list<Directive>& directives, std::vector<ConfigurationToCheck>& configurations, AnalyzerInformation* analyzerInformation, DumpFile& fdump)
+{
+    const bool dump = (mSettings.dump || !mSettings.addons.empty()) && fdump.is_open();
+
+    // Tokenize and simplify the configurations. Each configuration owns its token list and reports into its
+    // own buffer, the buffers are forwarded in the order of the configurations afterwards.
+    const std::vector<std::exception_ptr> simplifyExceptions = executeParallel(configurations.size(), mSettings.configJobs, [&](std::size_t i) {
+        if (Settings::terminated())
+            return;
+
+        ConfigurationToCheck &cfg = configurations[i];
+        cfg.tokenizer.reset(new Tokenizer(std::move(cfg.tokenlist), cfg.errorLogger));
+        Tokenizer &tokenizer = *cfg.tokenizer;
+        try {
+            tokenizer.setTimerResults(mTimerResults);
+            tokenizer.setDirectives(directives);
+
+            cfg.locationMacros = CppCheckLogger::getLocationMacros(tokenizer.tokens(), files);
+
+            if (cfg.reportChecking)
+                cfg.errorLogger.reportOut("Checking " + Path::toNativeSeparators(file.spath()) + ": " + cfg.currentConfig + "...", Color::FgGreen);
+
+            if (!tokenizer.tokens())
+                return;
+
+#ifdef HAVE_RULES
+            // Execute rules for "raw" code
+            executeRules("raw", tokenizer.list, cfg.errorLogger);
+#endif
+
+            if (!tokenizer.simplifyTokens1(cfg.currentConfig, file.fsFileId()))
+                return;
+
+            if (mSettings.memstats)
+                reportMemstats(cfg.errorLogger, Path::toNativeSeparators(file.spath()), cfg.currentConfig, tokenizer.list);
+
+            if (dump) {
+                Timer::run("CppCheck::dump", mTimerResults, [&]() {
+                    std::ostringstream oss;
+                    oss << "<dump cfg=\"" << ErrorLogger::toxml(cfg.currentConfig) << "\">\n";
+                    oss << "  <standards>\n";
+                    oss << "    <c version=\"" << mSettings.standards.getC() << "\"/>\n";
+                    oss << "    <cpp version=\"" << mSettings.standards.getCPP() << "\"/>\n";
+                    oss << "  </standards>\n";
+                    oss << getLibraryDumpData();
+                    oss << cfg.preprocessorDump;
+                    tokenizer.dump(oss);
+                    oss << "</dump>\n";
+                    cfg.dump = oss.str();
+                });
+            }
+
+            cfg.simplified = true;
+        } catch (const InternalError &e) {
+            cfg.errorLogger.reportErr(ErrorMessage::fromInternalError(e, &tokenizer.list, file.spath()));
+        }
+    });
+
+    // Skip configurations which have the same simplified token list as a previous configuration
+    std::set<std::size_t> hashes;
+    for (std::size_t i = 0; i < configurations.size() && !simplifyExceptions[i]; ++i) {
+        ConfigurationToCheck &cfg = configurations[i];
+        if (!cfg.simplified)
+            continue;
+
+        if (mSettings.inlineSuppressions) {
+            // Need to call this even if the hash will skip this configuration
+            mSuppressions.nomsg.markUnmatchedInlineSuppressionsAsChecked(cfg.tokenizer->list);
+        }
+
+        if (mSettings.getMaxConfigs() > 1)
+            cfg.purged = !hashes.insert(cfg.tokenizer->list.calculateHash()).second;
+    }
+
+    const std::vector<std::exception_ptr> checkExceptions = executeParallel(configurations.size(), mSettings.configJobs, [&](std::size_t i) {
+        ConfigurationToCheck &cfg = configurations[i];
+        if (!cfg.simplified || cfg.purged || simplifyExceptions[i] || Settings::terminated())
+            return;
+        try {
+            cfg.checked = runChecks(*cfg.tokenizer, cfg.errorLogger);
+        } catch (const InternalError &e) {
+            cfg.errorLogger.reportErr(ErrorMessage::fromInternalError(e, &cfg.tokenizer->list, file.spath()));
+        }
+    });
+
+    for (std::size_t i = 0; i < configurations.size(); ++i) {
+        if (Settings::terminated())
+            break;
+
+        ConfigurationToCheck &cfg = configurations[i];
+        if (!cfg.tokenizer)
+            continue;
+
+        mLogger->setLocationMacros(std::move(cfg.locationMacros));
+        cfg.errorLogger.forward(mErrorLogger);
+
+        if (simplifyExceptions[i])
+            std::rethrow_exception(simplifyExceptions[i]);
+        if (!cfg.simplified)
+            continue;
+
+        if (!cfg.dump.empty()) {
+            Timer::run("CppCheck::dump", mTimerResults, [&]() {
+                fdump << cfg.dump;
+            });
+            // the dump is not needed anymore
+            std::string().swap(cfg.dump);
+        }
+
+        if (cfg.purged) {
+            if (mSettings.debugwarnings)
+                purgedConfigurationMessage(file.spath(), cfg.currentConfig);
+            continue;
+        }
+
+        if (checkExceptions[i])
+            std::rethrow_exception(checkExceptions[i]);
+        if (!cfg.checked)
+            continue;
+
+        try {
+            getFileInfo(*cfg.tokenizer, analyzerInformation, cfg.currentConfig);
+        } catch (const InternalError &e) {
+            mErrorLogger.reportErr(ErrorMessage::fromInternalError(e, &cfg.tokenizer->list, file.spath()));
+        }
+
+        cfg.tokenizer.reset();
+    }
+}
+
 // TODO: replace with ErrorMessage::fromInternalError()
 void CppCheck::internalError(const std::string &filename, const std::string &msg)
 {
@@ -1356,42 +1634,87 @@ void CppCheck::internalError(const std::string &filename, const std::string &msg
 
 void CppCheck::checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation* analyzerInformation, const std::string& currentConfig)
 {
-    const ProgressReporter progressReporter(mErrorLogger, mSettings.reportProgress, tokenizer.list.getSourceFilePath(), "Run checkers");
+    if (runChecks(tokenizer, mErrorLogger))
+        getFileInfo(tokenizer, analyzerInformation, currentConfig);
+}
 
-    CheckUnusedFunctions unusedFunctionsChecker;
+bool CppCheck::runChecks(const Tokenizer &tokenizer, ErrorLogger &errorLogger)
+{
+    const ProgressReporter progressReporter(errorLogger, mSettings.reportProgress, tokenizer.list.getSourceFilePath(), "Run checkers");
 
     // TODO: this should actually be the behavior if only "--enable=unusedFunction" is specified - see #10648
     // TODO: log message when this is active?
-    const bool doUnusedFunctionOnly = Settings::unusedFunctionOnly();
+    if (Settings::unusedFunctionOnly())
+        return true;
 
-    if (!doUnusedFunctionOnly) {
-        const std::time_t maxTime = mSettings.checksMaxTime > 0 ? std::time(nullptr) + mSettings.checksMaxTime : 0;
+    const std::time_t maxTime = mSettings.checksMaxTime > 0 ? std::time(nullptr) + mSettings.checksMaxTime : 0;
 
-        // call all "runChecks" in all registered Check classes
-        for (Check * const c : CheckInstances::get()) {
-            if (Settings::terminated())
-                return;
+    const auto checksMaxTimeExceeded = [&]() {
+        if (mSettings.debugwarnings) {
+            ErrorMessage::FileLocation loc(tokenizer.list.getFiles()[0], 0, 0);
+            ErrorMessage errmsg({std::move(loc)},
+                                "",
+                                Severity::debug,
+                                "Checks maximum time exceeded",
+                                "checksMaxTime",
+                                Certainty::normal);
+            errorLogger.reportErr(errmsg);
+        }
+    };
 
-            if (maxTime > 0 && std::time(nullptr) > maxTime) {
-                if (mSettings.debugwarnings) {
-                    ErrorMessage::FileLocation loc(tokenizer.list.getFiles()[0], 0, 0);
-                    ErrorMessage errmsg({std::move(loc)},
-                                        "",
-                                        Severity::debug,
-                                        "Checks maximum time exceeded",
-                                        "checksMaxTime",
-                                        Certainty::normal);
-                    mErrorLogger.reportErr(errmsg);
-                }
+    if (mSettings.checksJobs > 1) {
+        // call all "runChecks" in all registered Check classes in parallel, the results are buffered per check
+        // and forwarded in the order of the registered checks so the output matches the serial execution
+        const std::vector<Check *> checks(CheckInstances::get().cbegin(), CheckInstances::get().cend());
+        std::vector<BufferedErrorLogger> buffers(checks.size());
+        std::vector<char> skipped(checks.size(), 0);
+
+        const std::vector<std::exception_ptr> exceptions = executeParallel(checks.size(), mSettings.checksJobs, [&](std::size_t i) {
+            if (Settings::terminated() || (maxTime > 0 && std::time(nullptr) > maxTime)) {
+                skipped[i] = 1;
                 return;
             }
-
-            Timer::run(c->name() + "::runChecks", mTimerResults, [&]() {
-                c->runChecks(tokenizer, mErrorLogger);
+            Timer::run(checks[i]->name() + "::runChecks", mTimerResults, [&]() {
+                checks[i]->runChecks(tokenizer, buffers[i]);
             });
+        });
+
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            if (skipped[i]) {
+                if (!Settings::terminated())
+                    checksMaxTimeExceeded();
+                return false;
+            }
+            buffers[i].forward(errorLogger);
+            if (exceptions[i])
+                std::rethrow_exception(exceptions[i]);
         }
+        return true;
     }
 
+    // call all "runChecks" in all registered Check classes
+    for (Check * const c : CheckInstances::get()) {
+        if (Settings::terminated())
+            return false;
+
+        if (maxTime > 0 && std::time(nullptr) > maxTime) {
+            checksMaxTimeExceeded();
+            return false;
+        }
+
+        Timer::run(c->name() + "::runChecks", mTimerResults, [&]() {
+            c->runChecks(tokenizer, errorLogger);
+        });
+    }
+    return true;
+}
+
+void CppCheck::getFileInfo(const Tokenizer &tokenizer, AnalyzerInformation* analyzerInformation, const std::string& currentConfig)
+{
+    CheckUnusedFunctions unusedFunctionsChecker;
+
+    const bool doUnusedFunctionOnly = Settings::unusedFunctionOnly();
+
     if (mSettings.checks.isEnabled(Checks::unusedFunction) && !mSettings.buildDir.empty()) {
         unusedFunctionsChecker.parseTokens(tokenizer, mSettings.library);
     }
@@ -1435,7 +1758,7 @@ void CppCheck::checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation
     }
 
 #ifdef HAVE_RULES
-    executeRules("normal", tokenizer.list);
+    executeRules("normal", tokenizer.list, mErrorLogger);
 #endif
 }
 
@@ -1449,7 +1772,7 @@ bool CppCheck::hasRule(const std::string &tokenlist) const
     });
 }
 
-void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
+void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list, ErrorLogger &errorLogger)
 {
     // There is no rule to execute
     if (!hasRule(tokenlist))
@@ -1467,7 +1790,7 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
             continue;
 
         if (!mSettings.quiet) {
-            mErrorLogger.reportOut("Processing rule: " + rule.pattern, Color::FgGreen);
+            errorLogger.reportOut("Processing rule: " + rule.pattern, Color::FgGreen);
         }
 
         auto f = [&](int pos1, int pos2) {
@@ -1498,7 +1821,7 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
                                       Certainty::normal);
 
             // Report error
-            mErrorLogger.reportErr(errmsg);
+            errorLogger.reportErr(errmsg);
         };
 
         const std::string err = rule.regex->match(str, f);
@@ -1510,7 +1833,7 @@ void CppCheck::executeRules(const std::string &tokenlist, const TokenList &list)
                                       "pcre_exec",
                                       Certainty::normal);
 
-            mErrorLogger.reportErr(errmsg);
+            errorLogger.reportErr(errmsg);
         }
     }
 }
@@ -1559,7 +1882,9 @@ void CppCheck::executeAddons(const std::vector<std::string>& files, const std::s
         std::vector<picojson::value> results;
 
         try {
-            results = executeAddon(addonInfo, mSettings.addonPython, fileList.empty() ? files[0] : fileList, mSettings.premiumArgs, mExecuteCommand);
+            Timer::run("CppCheck::executeAddons::" + addonInfo.name, mTimerResults, [&]() {
+                results = executeAddon(addonInfo, mSettings.addonPython, fileList.empty() ? files[0] : fileList, mSettings.premiumArgs, mExecuteCommand, mExecuteAddon);
+            });
         } catch (const InternalError& e) {
             const std::string ctx = isCtuInfo ? "Whole program analysis" : "Checking file";
             const ErrorMessage errmsg = ErrorMessage::fromInternalError(e, nullptr, file0, "Bailing out from analysis: " + ctx + " failed");
@@ -1860,8 +2185,7 @@ bool CppCheck::analyseWholeProgram()
             }
         }
 
-        for (Check * const c : CheckInstances::get())
-            errors |= c->analyseWholeProgram(ctu, mFileInfo, mSettings, mErrorLogger);  // TODO: ctu
+        errors |= analyseWholeProgramChecks(ctu, mFileInfo, mSettings, mErrorLogger);  // TODO: ctu
     }
 
     if (mUnusedFunctionsCheck)
@@ -1886,29 +2210,44 @@ unsigned int CppCheck::analyseWholeProgram(const std::string &buildDir, const st
     std::list<const Check::FileInfo*> fileInfoList;
     CTU::FileInfo ctuFileInfo;
 
-    const auto handler = [&fileInfoList, &ctuFileInfo](const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
-        if (std::strcmp(checkattr, "ctu") == 0) {
-            ctuFileInfo.loadFromXml(e);
-            return;
-        }
-        for (const Check *check : CheckInstances::get()) {
-            if (checkattr == check->name()) {
-                if (const Check::FileInfo* fi = check->loadFileInfoFromXml(e, filesTxtInfo.sourceFile)) {
-                    fileInfoList.push_back(fi);
+    std::vector<AnalyzerInformation::Info> filesTxtInfos;
+    std::string err = AnalyzerInformation::readFilesTxt(buildDir, filesTxtInfos);
+    if (err.empty()) {
+        // the analyzer information files are loaded in parallel into a shard per file. the shards are
+        // merged in the order of files.txt so the results do not depend on the number of jobs.
+        std::vector<WholeProgramShard> shards(filesTxtInfos.size());
+
+        const auto handler = [&shards](std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
+            WholeProgramShard &shard = shards[fileIndex];
+            if (std::strcmp(checkattr, "ctu") == 0) {
+                shard.ctu.loadFromXml(e);
+                return;
+            }
+            for (const Check *check : CheckInstances::get()) {
+                if (checkattr == check->name()) {
+                    if (const Check::FileInfo* fi = check->loadFileInfoFromXml(e, filesTxtInfo.sourceFile)) {
+                        shard.fileInfo.push_back(fi);
+                    }
                 }
             }
+        };
+
+        err = AnalyzerInformation::processFilesTxt(buildDir, filesTxtInfos, handler, mSettings.debugainfo, mSettings.jobs);
+
+        for (WholeProgramShard &shard : shards) {
+            ctuFileInfo.functionCalls.splice(ctuFileInfo.functionCalls.end(), shard.ctu.functionCalls);
+            ctuFileInfo.nestedCalls.splice(ctuFileInfo.nestedCalls.end(), shard.ctu.nestedCalls);
+            fileInfoList.splice(fileInfoList.end(), shard.fileInfo);
         }
-    };
+    }
 
-    const std::string err = AnalyzerInformation::processFilesTxt(buildDir, handler, mSettings.debugainfo);
     if (!err.empty()) {
         const ErrorMessage errmsg({}, "", Severity::error, err, "internalError", Certainty::normal);
         mErrorLogger.reportErr(errmsg);
     }
     else {
         // Analyse the tokens
-        for (Check * const c : CheckInstances::get())
-            c->analyseWholeProgram(ctuFileInfo, fileInfoList, mSettings, mErrorLogger);
+        analyseWholeProgramChecks(ctuFileInfo, fileInfoList, mSettings, mErrorLogger);
     }
 
     for (const Check::FileInfo *fi : fileInfoList)
@@ -1929,32 +2268,20 @@ bool CppCheck::isPremiumCodingStandardId(const std::string& id) const {
 
 std::string CppCheck::getDumpFileContentsRawTokens(const std::vector<std::string>& files, const simplecpp::TokenList& tokens1) const
 {
-    std::string header = getDumpFileContentsRawTokensHeader(files);
-    std::string footer = getDumpFileContentsRawTokensFooter(tokens1);
-    return getDumpFileContentsRawTokens(header, footer);
-}
-
-std::string CppCheck::getDumpFileContentsRawTokens(const std::string& header, const std::string& footer)
-{
-    std::string dumpProlog;
-    dumpProlog += "  <rawtokens>\n";
-    dumpProlog += header;
-    dumpProlog += footer;
-    dumpProlog += "  </rawtokens>\n";
-    return dumpProlog;
+    std::ostringstream oss;
+    writeDumpFileContentsRawTokens(oss, files, getDumpFileContentsRawTokensFooter(tokens1));
+    return oss.str();
 }
 
-std::string CppCheck::getDumpFileContentsRawTokensHeader(const std::vector<std::string>& files) const
+void CppCheck::writeDumpFileContentsRawTokens(std::ostream& out, const std::vector<std::string>& files, const std::string& tokens) const
 {
-    std::string dumpProlog;
+    out << "  <rawtokens>\n";
     for (unsigned int i = 0; i < files.size(); ++i) {
-        dumpProlog += "    <file index=\"";
-        dumpProlog += std::to_string(i);
-        dumpProlog += "\" name=\"";
-        dumpProlog += ErrorLogger::toxml(Path::getRelativePath(files[i], mSettings.basePaths));
-        dumpProlog += "\"/>\n";
+        out << "    <file index=\"" << i << "\" name=\""
+            << ErrorLogger::toxml(Path::getRelativePath(files[i], mSettings.basePaths)) << "\"/>\n";
     }
-    return dumpProlog;
+    out << tokens;
+    out << "  </rawtokens>\n";
 }
 
 std::string CppCheck::getDumpFileContentsRawTokensFooter(const simplecpp::TokenList& tokens1)
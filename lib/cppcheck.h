@@ -26,19 +26,23 @@
 
 #include <cstddef>
 #include <functional>
+#include <iosfwd>
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #ifdef HAVE_RULES
 class TokenList;
 #endif
+struct Directive;
 struct FileSettings;
 class CheckUnusedFunctions;
 class Tokenizer;
 class FileWithDetails;
 class AnalyzerInformation;
+class DumpFile;
 class ErrorLogger;
 class Settings;
 struct Suppressions;
@@ -66,6 +70,9 @@ public:
     // exe, args, redirect, output
     using ExecuteCmdFn = std::function<int (std::string,std::vector<std::string>,std::string,std::string&)>;
 
+    // exe, server args, request args, output, exitcode - returns false if the addon could not be executed by a server
+    using ExecuteAddonFn = std::function<bool (const std::string&,const std::vector<std::string>&,const std::vector<std::string>&,std::string&,int&)>;
+
     /**
      * @brief Constructor.
      */
@@ -81,6 +88,15 @@ public:
      */
     ~CppCheck();
 
+    /**
+     * @brief Execute the Python addons through a long-lived addon server instead of
+     * starting the interpreter for every file. The command callback is used when
+     * the server fails.
+     */
+    void setExecuteAddon(ExecuteAddonFn executeAddon) {
+        mExecuteAddon = std::move(executeAddon);
+    }
+
     /**
      * @brief This starts the actual checking. Note that you must call
      * parseFromArgs() or settings() and addFile() before calling this.
@@ -153,11 +169,18 @@ private:
      * @brief Get dumpfile <rawtokens> contents, this is only public for testing purposes
      */
     std::string getDumpFileContentsRawTokens(const std::vector<std::string>& files, const simplecpp::TokenList& tokens1) const;
-    static std::string getDumpFileContentsRawTokens(const std::string& header, const std::string& footer);
-    std::string getDumpFileContentsRawTokensHeader(const std::vector<std::string>& files) const;
+    /**
+     * @brief Write the dumpfile <rawtokens> element
+     * @param out the dump file
+     * @param files the source files
+     * @param tokens the <tok> elements of the raw tokens (see getDumpFileContentsRawTokensFooter())
+     */
+    void writeDumpFileContentsRawTokens(std::ostream& out, const std::vector<std::string>& files, const std::string& tokens) const;
     static std::string getDumpFileContentsRawTokensFooter(const simplecpp::TokenList& tokens1);
 
-    std::string getLibraryDumpData() const;
+    const std::string& getLibraryDumpData() const {
+        return mLibraryDumpData;
+    }
 
     /** Analyze all files using clang-tidy */
     void analyseClangTidy(const FileSettings &fileSettings);
@@ -210,6 +233,19 @@ private:
      */
     unsigned int checkInternal(const FileWithDetails& file, const std::string &cfgname, const CreateTokenListFn& createTokenList);
 
+    struct ConfigurationToCheck;
+
+    /**
+     * @brief Check preprocessed configurations of a file concurrently
+     * @param file the file
+     * @param files the files used by the token lists
+     * @param directives the preprocessor directives
+     * @param configurations the preprocessed configurations
+     * @param analyzerInformation the analyzer information
+     * @param fdump the dump file
+     */
+    void checkConfigurations(const FileWithDetails& file, const std::vector<std::string>& files, const std::list<Directive>& directives, std::vector<ConfigurationToCheck>& configurations, AnalyzerInformation* analyzerInformation, DumpFile& fdump);
+
     /**
      * @brief Check normal tokens
      * @param tokenizer tokenizer instance
@@ -217,6 +253,21 @@ private:
      */
     void checkNormalTokens(const Tokenizer &tokenizer, AnalyzerInformation* analyzerInformation, const std::string& currentConfig);
 
+    /**
+     * @brief Run all registered checks on the normal tokens
+     * @param tokenizer tokenizer instance
+     * @param errorLogger the logger the checks report to
+     * @return false if the checks were not completed
+     */
+    bool runChecks(const Tokenizer &tokenizer, ErrorLogger &errorLogger);
+
+    /**
+     * @brief Collect the information for the whole program analysis
+     * @param tokenizer tokenizer instance
+     * @param analyzerInformation the analyzer information
+     */
+    void getFileInfo(const Tokenizer &tokenizer, AnalyzerInformation* analyzerInformation, const std::string& currentConfig);
+
     /**
      * Execute addons
      */
@@ -233,8 +284,9 @@ private:
      * @brief Execute rules, if any
      * @param tokenlist token list to use (define / normal / raw)
      * @param list token list
+     * @param errorLogger the logger the results are reported to
      */
-    void executeRules(const std::string &tokenlist, const TokenList &list);
+    void executeRules(const std::string &tokenlist, const TokenList &list, ErrorLogger &errorLogger);
 #endif
 
     unsigned int checkClang(const FileWithDetails &file);
@@ -258,7 +310,13 @@ private:
     /** Callback for executing a shell command (exe, args, output) */
     ExecuteCmdFn mExecuteCommand;
 
+    /** Callback for executing an addon by an addon server (optional) */
+    ExecuteAddonFn mExecuteAddon;
+
     std::unique_ptr<CheckUnusedFunctions> mUnusedFunctionsCheck;
+
+    /** The <library> elements of the dump file, they are the same for all files and configurations */
+    std::string mLibraryDumpData;
 };
 
 /// @}
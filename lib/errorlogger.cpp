@@ -33,14 +33,22 @@
 #include <array>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <cstring>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <list>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
 
 #include "xml.h"
 
@@ -606,13 +614,108 @@ std::string ErrorMessage::toXML() const
 }
 
 // TODO: read info from some shared resource instead?
+namespace {
+    /**
+     * Cache of the source files shown by {code}. A file is read once and the offsets of its lines
+     * are stored so every line is found directly. The least recently used files are dropped when
+     * the cached content exceeds the memory budget.
+     */
+    class SourceLineCache {
+    public:
+        explicit SourceLineCache(std::size_t maxSize) : mMaxSize(maxSize) {}
+
+        /** Get line @p linenr of @p file like reading the lines with std::getline() */
+        std::string getLine(const std::string &file, int linenr) {
+            struct stat fileStat;
+            if (stat(file.c_str(), &fileStat) != 0)
+                return "";
+
+            std::lock_guard<std::mutex> guard(mMutex);
+            auto it = mFiles.find(file);
+            if (it != mFiles.end() && (it->second.size != static_cast<std::uint64_t>(fileStat.st_size) || it->second.mtime != fileStat.st_mtime)) {
+                // the file has been modified
+                remove(it);
+                it = mFiles.end();
+            }
+            if (it == mFiles.end()) {
+                it = load(file);
+                if (it == mFiles.end())
+                    return "";
+                it->second.size = static_cast<std::uint64_t>(fileStat.st_size);
+                it->second.mtime = fileStat.st_mtime;
+            } else {
+                mLru.splice(mLru.begin(), mLru, it->second.lru);
+            }
+
+            const File &f = it->second;
+            if (linenr <= 0)
+                return "";
+            // std::getline() keeps the last line if the file does not end with a newline
+            if (static_cast<std::size_t>(linenr) >= f.lineOffsets.size()) {
+                if (f.content.empty() || f.content.back() == '\n')
+                    return "";
+                linenr = static_cast<int>(f.lineOffsets.size()) - 1;
+            }
+            const std::size_t start = f.lineOffsets[linenr - 1];
+            const std::size_t end = f.lineOffsets[linenr];
+            return f.content.substr(start, end - start - ((end > start && f.content[end - 1] == '\n') ? 1 : 0));
+        }
+
+    private:
+        struct File {
+            std::string content;
+            /** start of each line followed by the end of the content */
+            std::vector<std::size_t> lineOffsets;
+            std::list<std::string>::iterator lru;
+            std::uint64_t size{};
+            std::time_t mtime{};
+        };
+
+        std::unordered_map<std::string, File>::iterator load(const std::string &file) {
+            std::ifstream fin(file, std::ios::binary);
+            if (!fin.is_open())
+                return mFiles.end();
+            std::ostringstream oss;
+            oss << fin.rdbuf();
+
+            File f;
+            f.content = oss.str();
+            f.lineOffsets.push_back(0);
+            for (std::string::size_type pos = f.content.find('\n'); pos != std::string::npos; pos = f.content.find('\n', pos + 1))
+                f.lineOffsets.push_back(pos + 1);
+            if (f.lineOffsets.back() != f.content.size())
+                f.lineOffsets.push_back(f.content.size());
+
+            mSize += f.content.size();
+            mLru.push_front(file);
+            f.lru = mLru.begin();
+            const auto it = mFiles.emplace(file, std::move(f)).first;
+
+            // the file that was just loaded is kept even if it exceeds the budget on its own
+            while (mSize > mMaxSize && mLru.size() > 1)
+                remove(mFiles.find(mLru.back()));
+            return it;
+        }
+
+        void remove(std::unordered_map<std::string, File>::iterator it) {
+            mSize -= it->second.content.size();
+            mLru.erase(it->second.lru);
+            mFiles.erase(it);
+        }
+
+        const std::size_t mMaxSize;
+        std::size_t mSize{};
+        std::unordered_map<std::string, File> mFiles;
+        /** most recently used file first */
+        std::list<std::string> mLru;
+        std::mutex mMutex;
+    };
+}
+
 static std::string readCode(const std::string &file, int linenr, int column, const char endl[])
 {
-    std::ifstream fin(file);
-    std::string line;
-    while (linenr > 0 && std::getline(fin,line)) {
-        linenr--;
-    }
+    static SourceLineCache sourceLineCache(64 * 1024 * 1024);
+    std::string line = sourceLineCache.getLine(file, linenr);
     const std::string::size_type endPos = line.find_last_not_of("\r\n\t ");
     if (endPos + 1 < line.size())
         line.erase(endPos + 1);
@@ -26,6 +26,7 @@
 
 #include <cstdint>
 #include <ctime>
+#include <functional>
 #include <list>
 #include <set>
 #include <sstream>
@@ -297,6 +298,44 @@ private:
     static const std::set<std::string> mCriticalErrorIds;
 };
 
+/**
+ * @brief Collects everything that is reported so it can be forwarded to
+ * another ErrorLogger at a later time in the original order.
+ */
+class CPPCHECKLIB BufferedErrorLogger : public ErrorLogger {
+public:
+    void reportOut(const std::string &outmsg, Color c) override
+    {
+        mReports.emplace_back([outmsg, c](ErrorLogger &errorLogger) {
+            errorLogger.reportOut(outmsg, c);
+        });
+    }
+
+    void reportErr(const ErrorMessage &msg) override
+    {
+        mReports.emplace_back([msg](ErrorLogger &errorLogger) {
+            errorLogger.reportErr(msg);
+        });
+    }
+
+    void reportMetric(const std::string &metric) override
+    {
+        mReports.emplace_back([metric](ErrorLogger &errorLogger) {
+            errorLogger.reportMetric(metric);
+        });
+    }
+
+    void forward(ErrorLogger &errorLogger)
+    {
+        for (const auto &report : mReports)
+            report(errorLogger);
+        mReports.clear();
+    }
+
+private:
+    std::vector<std::function<void(ErrorLogger&)>> mReports;
+};
+
 /// RAII class for reporting progress messages
 class CPPCHECKLIB ProgressReporter {
 public:
@@ -0,0 +1,144 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "headercache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+HeaderCache::HeaderCache(std::size_t maxTokens)
+    : mMaxTokens(maxTokens)
+{}
+
+HeaderCache &HeaderCache::instance()
+{
+    // about 100 MiB
+    static HeaderCache headerCache(500000);
+    return headerCache;
+}
+
+simplecpp::TokenList HeaderCache::tokenize(const std::string &path, std::vector<std::string> &filenames, simplecpp::OutputList *outputList)
+{
+    std::ifstream fin(path, std::ios::binary);
+    if (mMaxTokens == 0 || !fin.is_open())
+        return simplecpp::TokenList(path, filenames, outputList);
+    std::ostringstream oss;
+    oss << fin.rdbuf();
+    const std::string content = oss.str();
+    const std::size_t hash = std::hash<std::string>{}(content);
+
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        const auto it = mEntries.find(path);
+        if (it != mEntries.end()) {
+            if (it->second->hash == hash && it->second->size == content.size()) {
+                mLru.splice(mLru.begin(), mLru, it->second->lru);
+                entry = it->second;
+            } else {
+                // the file has been modified
+                remove(it);
+            }
+        }
+    }
+    if (entry) {
+        ++mHits;
+        return copy(*entry, filenames, outputList);
+    }
+    ++mMisses;
+
+    auto newEntry = std::make_shared<Entry>();
+    std::istringstream istr(content);
+    newEntry->tokens = simplecpp::TokenList(istr, newEntry->files, path, &newEntry->output);
+    newEntry->hash = hash;
+    newEntry->size = content.size();
+    for (const simplecpp::Token *tok = newEntry->tokens.cfront(); tok; tok = tok->next)
+        ++newEntry->tokenCount;
+
+    simplecpp::TokenList tokens = copy(*newEntry, filenames, outputList);
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    // another thread might have tokenized the same file in the meantime
+    const auto it = mEntries.find(path);
+    if (it != mEntries.end())
+        remove(it);
+    mLru.push_front(path);
+    newEntry->lru = mLru.begin();
+    mTokenCount += newEntry->tokenCount;
+    mEntries.emplace(path, std::move(newEntry));
+    while (mTokenCount > mMaxTokens && !mLru.empty())
+        remove(mEntries.find(mLru.back()));
+    return tokens;
+}
+
+simplecpp::TokenList HeaderCache::copy(const Entry &entry, std::vector<std::string> &filenames, simplecpp::OutputList *outputList)
+{
+    // register the files in the same order as the tokenizer did
+    std::vector<unsigned int> fileIndex;
+    fileIndex.reserve(entry.files.size());
+    for (const std::string &f : entry.files) {
+        const auto it = std::find(filenames.cbegin(), filenames.cend(), f);
+        if (it != filenames.cend()) {
+            fileIndex.push_back(static_cast<unsigned int>(std::distance(filenames.cbegin(), it)));
+        } else {
+            fileIndex.push_back(static_cast<unsigned int>(filenames.size()));
+            filenames.push_back(f);
+        }
+    }
+
+    simplecpp::TokenList tokens(filenames);
+    for (const simplecpp::Token *tok = entry.tokens.cfront(); tok; tok = tok->next) {
+        auto *const newtok = new simplecpp::Token(*tok);
+        newtok->location.fileIndex = fileIndex[tok->location.fileIndex];
+        tokens.push_back(newtok);
+    }
+    if (outputList) {
+        for (const simplecpp::Output &output : entry.output) {
+            outputList->push_back(output);
+            if (output.location.fileIndex < fileIndex.size())
+                outputList->back().location.fileIndex = fileIndex[output.location.fileIndex];
+        }
+    }
+    return tokens;
+}
+
+void HeaderCache::remove(std::unordered_map<std::string, std::shared_ptr<Entry>>::iterator it)
+{
+    mTokenCount -= it->second->tokenCount;
+    mLru.erase(it->second->lru);
+    mEntries.erase(it);
+}
+
+HeaderCache::Statistics HeaderCache::getStatistics() const
+{
+    return Statistics{mHits, mMisses};
+}
+
+void HeaderCache::clear()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mEntries.clear();
+    mLru.clear();
+    mTokenCount = 0;
+    mHits = 0;
+    mMisses = 0;
+}
@@ -0,0 +1,107 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef headercacheH
+#define headercacheH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <simplecpp.h>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Cache of the raw tokens of the included files
+ *
+ * The same headers are included by many translation units. The raw tokens of a
+ * header do not depend on the configuration or on the macros defined when it is
+ * included, so a header is only tokenized again when its content has changed.
+ * Every translation unit gets its own copy of the tokens. The least recently used
+ * headers are dropped when the cached tokens exceed the budget. It is thread-safe.
+ */
+class CPPCHECKLIB HeaderCache {
+public:
+    /** @param maxTokens number of cached tokens before headers are dropped - 0 disables the cache */
+    explicit HeaderCache(std::size_t maxTokens);
+
+    HeaderCache(const HeaderCache &) = delete;
+    HeaderCache &operator=(const HeaderCache &) = delete;
+
+    /** the cache shared by all the files checked in this process */
+    static HeaderCache &instance();
+
+    struct Statistics {
+        std::size_t hits;
+        std::size_t misses;
+    };
+
+    /**
+     * Get the raw tokens of the file @p path. The locations of the tokens refer
+     * to @p filenames like the tokens created by simplecpp::TokenList.
+     */
+    simplecpp::TokenList tokenize(const std::string &path, std::vector<std::string> &filenames, simplecpp::OutputList *outputList);
+
+    Statistics getStatistics() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        Entry() : tokens(files) {}
+        Entry(const Entry &) = delete;
+        Entry &operator=(const Entry &) = delete;
+
+        std::vector<std::string> files;
+        simplecpp::TokenList tokens;
+        simplecpp::OutputList output;
+        std::size_t hash{};
+        std::size_t size{};
+        std::size_t tokenCount{};
+        std::list<std::string>::iterator lru;
+    };
+
+    static simplecpp::TokenList copy(const Entry &entry, std::vector<std::string> &filenames, simplecpp::OutputList *outputList);
+
+    void remove(std::unordered_map<std::string, std::shared_ptr<Entry>>::iterator it);
+
+    const std::size_t mMaxTokens;
+    std::size_t mTokenCount{};
+    std::unordered_map<std::string, std::shared_ptr<Entry>> mEntries;
+    /** most recently used file first */
+    std::list<std::string> mLru;
+    mutable std::mutex mMutex;
+
+    std::atomic<std::size_t> mHits{};
+    std::atomic<std::size_t> mMisses{};
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // headercacheH
@@ -32,7 +32,7 @@
 #include <utility>
 
 template<class Predicate, class Compare>
-static const ValueFlow::Value* getCompareValue(const std::list<ValueFlow::Value>& values, Predicate pred, Compare compare)
+static const ValueFlow::Value* getCompareValue(const std::vector<ValueFlow::Value>& values, Predicate pred, Compare compare)
 {
     const ValueFlow::Value* result = nullptr;
     for (const ValueFlow::Value& value : values) {
@@ -122,7 +122,7 @@ namespace {
         }
 
         template<class Predicate>
-        static Interval fromValues(const std::list<ValueFlow::Value>& values, Predicate predicate)
+        static Interval fromValues(const std::vector<ValueFlow::Value>& values, Predicate predicate)
         {
             Interval result;
             const ValueFlow::Value* minValue = getCompareValue(values, predicate, std::less<MathLib::bigint>{});
@@ -146,7 +146,7 @@ namespace {
             return result;
         }
 
-        static Interval fromValues(const std::list<ValueFlow::Value>& values)
+        static Interval fromValues(const std::vector<ValueFlow::Value>& values)
         {
             return Interval::fromValues(values, [](const ValueFlow::Value&) {
                 return true;
@@ -276,7 +276,7 @@ static void setValueKind(ValueFlow::Value& value, const std::vector<const ValueF
         value.setKnown();
 }
 
-static bool inferNotEqual(const std::list<ValueFlow::Value>& values, MathLib::bigint x)
+static bool inferNotEqual(const std::vector<ValueFlow::Value>& values, MathLib::bigint x)
 {
     return std::any_of(values.cbegin(), values.cend(), [&](const ValueFlow::Value& value) {
         return value.isImpossible() && value.intvalue == x;
@@ -285,17 +285,17 @@ static bool inferNotEqual(const std::list<ValueFlow::Value>& values, MathLib::bi
 
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
-                                    std::list<ValueFlow::Value> lhsValues,
-                                    std::list<ValueFlow::Value> rhsValues)
+                                    std::vector<ValueFlow::Value> lhsValues,
+                                    std::vector<ValueFlow::Value> rhsValues)
 {
     std::vector<ValueFlow::Value> result;
     auto notMatch = [&](const ValueFlow::Value& value) {
         return !model->match(value);
     };
-    lhsValues.remove_if(notMatch);
+    lhsValues.erase(std::remove_if(lhsValues.begin(), lhsValues.end(), notMatch), lhsValues.end());
     if (lhsValues.empty())
         return result;
-    rhsValues.remove_if(notMatch);
+    rhsValues.erase(std::remove_if(rhsValues.begin(), rhsValues.end(), notMatch), rhsValues.end());
     if (rhsValues.empty())
         return result;
 
@@ -363,26 +363,26 @@ std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
                                     MathLib::bigint lhs,
-                                    std::list<ValueFlow::Value> rhsValues)
+                                    std::vector<ValueFlow::Value> rhsValues)
 {
     return infer(model, op, {model->yield(lhs)}, std::move(rhsValues));
 }
 
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
-                                    std::list<ValueFlow::Value> lhsValues,
+                                    std::vector<ValueFlow::Value> lhsValues,
                                     MathLib::bigint rhs)
 {
     return infer(model, op, std::move(lhsValues), {model->yield(rhs)});
 }
 
-std::vector<MathLib::bigint> getMinValue(const ValuePtr<InferModel>& model, const std::list<ValueFlow::Value>& values)
+std::vector<MathLib::bigint> getMinValue(const ValuePtr<InferModel>& model, const std::vector<ValueFlow::Value>& values)
 {
     return Interval::fromValues(values, [&](const ValueFlow::Value& v) {
         return model->match(v);
     }).minvalue;
 }
-std::vector<MathLib::bigint> getMaxValue(const ValuePtr<InferModel>& model, const std::list<ValueFlow::Value>& values)
+std::vector<MathLib::bigint> getMaxValue(const ValuePtr<InferModel>& model, const std::vector<ValueFlow::Value>& values)
 {
     return Interval::fromValues(values, [&](const ValueFlow::Value& v) {
         return model->match(v);
@@ -22,7 +22,6 @@
 #include "config.h"
 #include "mathlib.h"
 
-#include <list>
 #include <string>
 #include <vector>
 
@@ -45,21 +44,21 @@ protected:
 
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
-                                    std::list<ValueFlow::Value> lhsValues,
-                                    std::list<ValueFlow::Value> rhsValues);
+                                    std::vector<ValueFlow::Value> lhsValues,
+                                    std::vector<ValueFlow::Value> rhsValues);
 
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
                                     MathLib::bigint lhs,
-                                    std::list<ValueFlow::Value> rhsValues);
+                                    std::vector<ValueFlow::Value> rhsValues);
 
 std::vector<ValueFlow::Value> infer(const ValuePtr<InferModel>& model,
                                     const std::string& op,
-                                    std::list<ValueFlow::Value> lhsValues,
+                                    std::vector<ValueFlow::Value> lhsValues,
                                     MathLib::bigint rhs);
 
-CPPCHECKLIB std::vector<MathLib::bigint> getMinValue(const ValuePtr<InferModel>& model, const std::list<ValueFlow::Value>& values);
-std::vector<MathLib::bigint> getMaxValue(const ValuePtr<InferModel>& model, const std::list<ValueFlow::Value>& values);
+CPPCHECKLIB std::vector<MathLib::bigint> getMinValue(const ValuePtr<InferModel>& model, const std::vector<ValueFlow::Value>& values);
+std::vector<MathLib::bigint> getMaxValue(const ValuePtr<InferModel>& model, const std::vector<ValueFlow::Value>& values);
 
 ValuePtr<InferModel> makeIntegralInferModel();
 
@@ -1206,6 +1206,9 @@ std::string Library::getFunctionName(const Token *ftok, bool &error) const
 
 std::string Library::getFunctionName(const Token *ftok) const
 {
+    if (const std::string* name = ftok->libraryFunctionName(*this))
+        return *name;
+
     if (!Token::Match(ftok, "%name% )| (") && (ftok->strAt(-1) != "&" || ftok->previous()->astOperand2()))
         return "";
 
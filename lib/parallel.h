@@ -0,0 +1,136 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef parallelH
+#define parallelH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#ifdef HAS_THREADING_MODEL_THREAD
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+/**
+ * @brief Call @p f with every index in [0, count) using up to @p jobs threads.
+ *
+ * Indexes are handed out in ascending order. When only a single job is requested
+ * or threading is not available everything is executed on the calling thread.
+ *
+ * @return the exception thrown for each index (nullptr if none was thrown)
+ */
+template<class F>
+std::vector<std::exception_ptr> executeParallel(std::size_t count, unsigned int jobs, const F& f)
+{
+    std::vector<std::exception_ptr> exceptions(count);
+
+    const auto runOne = [&](std::size_t i) {
+        try {
+            f(i);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    };
+
+#ifdef HAS_THREADING_MODEL_THREAD
+    const std::size_t threadCount = std::min<std::size_t>(jobs, count);
+    if (threadCount > 1) {
+        std::atomic<std::size_t> next{0};
+        const auto worker = [&]() {
+            for (std::size_t i = next++; i < count; i = next++)
+                runOne(i);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (std::size_t t = 1; t < threadCount; ++t)
+            threads.emplace_back(worker);
+        worker();
+        for (std::thread &t : threads)
+            t.join();
+        return exceptions;
+    }
+#else
+    (void)jobs;
+#endif
+
+    for (std::size_t i = 0; i < count; ++i)
+        runOne(i);
+    return exceptions;
+}
+
+/**
+ * @brief Call @p f with every index in [0, count) using up to @p jobs threads. An index
+ * is only executed when all the indexes in its @p dependencies have been executed.
+ *
+ * Indexes are handed out in ascending order and an index may only depend on lower
+ * indexes so the execution cannot get stuck. When only a single job is requested or
+ * threading is not available everything is executed on the calling thread.
+ *
+ * @return the exception thrown for each index (nullptr if none was thrown)
+ */
+template<class F>
+std::vector<std::exception_ptr> executeParallel(std::size_t count, unsigned int jobs, const std::vector<std::vector<std::size_t>> &dependencies, const F& f)
+{
+#ifdef HAS_THREADING_MODEL_THREAD
+    if (std::min<std::size_t>(jobs, count) > 1) {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<char> done(count, 0);
+        return executeParallel(count, jobs, [&](std::size_t i) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&]() {
+                    return std::all_of(dependencies[i].cbegin(), dependencies[i].cend(), [&](std::size_t d) {
+                        return done[d] != 0;
+                    });
+                });
+            }
+            struct Done {
+                ~Done() {
+                    {
+                        const std::lock_guard<std::mutex> lock(mMutex);
+                        mDone = 1;
+                    }
+                    mCv.notify_all();
+                }
+                std::mutex &mMutex;
+                std::condition_variable &mCv;
+                char &mDone;
+            } markDone{mutex, cv, done[i]};
+            f(i);
+        });
+    }
+#else
+    (void)dependencies;
+#endif
+    // ascending order satisfies the dependencies
+    return executeParallel(count, 1, f);
+}
+
+//---------------------------------------------------------------------------
+#endif // parallelH
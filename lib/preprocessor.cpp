@@ -21,6 +21,7 @@
 
 #include "errorlogger.h"
 #include "errortypes.h"
+#include "headercache.h"
 #include "library.h"
 #include "mathlib.h"
 #include "path.h"
@@ -68,6 +69,10 @@ Preprocessor::Preprocessor(simplecpp::TokenList& tokens, const Settings& setting
     , mLang(lang)
 {
     assert(mLang != Standards::Language::None);
+    // the raw tokens of the included files are shared between the checked files
+    mFileCache.set_tokenize_callback([](const std::string &path, std::vector<std::string> &filenames, simplecpp::OutputList *outputList) {
+        return HeaderCache::instance().tokenize(path, filenames, outputList);
+    });
 }
 
 namespace {
@@ -1057,7 +1062,7 @@ void Preprocessor::dump(std::ostream &out) const
     // Create a xml dump.
 
     if (!mMacroUsage.empty()) {
-        out << "  <macro-usage>" << std::endl;
+        out << "  <macro-usage>" << '\n';
         for (const simplecpp::MacroUsage &macroUsage: mMacroUsage) {
             out << "    <macro"
                 << " name=\"" << macroUsage.macroName << "\""
@@ -1068,13 +1073,13 @@ void Preprocessor::dump(std::ostream &out) const
                 << " useline=\"" << macroUsage.useLocation.line << "\""
                 << " usecolumn=\"" << macroUsage.useLocation.col << "\""
                 << " is-known-value=\"" << bool_to_string(macroUsage.macroValueKnown) << "\""
-                << "/>" << std::endl;
+                << "/>" << '\n';
         }
-        out << "  </macro-usage>" << std::endl;
+        out << "  </macro-usage>" << '\n';
     }
 
     if (!mIfCond.empty()) {
-        out << "  <simplecpp-if-cond>" << std::endl;
+        out << "  <simplecpp-if-cond>" << '\n';
         for (const simplecpp::IfCond &ifCond: mIfCond) {
             out << "    <if-cond"
                 << " file=\"" << ErrorLogger::toxml(mTokens.file(ifCond.location)) << "\""
@@ -1082,9 +1087,9 @@ void Preprocessor::dump(std::ostream &out) const
                 << " column=\"" << ifCond.location.col << "\""
                 << " E=\"" << ErrorLogger::toxml(ifCond.E) << "\""
                 << " result=\"" << ifCond.result << "\""
-                << "/>" << std::endl;
+                << "/>" << '\n';
         }
-        out << "  </simplecpp-if-cond>" << std::endl;
+        out << "  </simplecpp-if-cond>" << '\n';
     }
 }
 
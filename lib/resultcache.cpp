@@ -0,0 +1,227 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resultcache.h"
+
+#include "path.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <unistd.h> // for getpid()
+#include <utime.h>
+#else
+#include <process.h> // for getpid()
+#include <sys/utime.h>
+#include <windows.h>
+#endif
+
+static const char entryExtension[] = ".ainfo";
+
+static std::atomic<std::size_t> s_hits;
+static std::atomic<std::size_t> s_misses;
+static std::atomic<std::size_t> s_stores;
+static std::atomic<std::size_t> s_evictions;
+static std::atomic<unsigned int> s_tempFileCounter;
+
+static int getPid()
+{
+#ifndef _WIN32
+    return getpid();
+#else
+    return _getpid();
+#endif
+}
+
+namespace {
+#ifndef _WIN32
+    struct DirCloser {
+        void operator()(DIR* dir) const {
+            closedir(dir);
+        }
+    };
+#endif
+
+    struct Entry {
+        std::string filename;
+        std::uint64_t size;
+        std::time_t mtime;
+    };
+}
+
+/** Get all cache entries in @p dir */
+static std::vector<Entry> getEntries(const std::string &dir)
+{
+    std::vector<Entry> entries;
+
+    const auto addEntry = [&](std::string name) {
+        if (!endsWith(name, entryExtension))
+            return;
+        std::string filename = Path::join(dir, std::move(name));
+        struct stat file_stat;
+        if (stat(filename.c_str(), &file_stat) == -1)
+            return; // removed by another process
+        entries.push_back(Entry{std::move(filename), static_cast<std::uint64_t>(file_stat.st_size), file_stat.st_mtime});
+    };
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA ffd;
+    HANDLE hFind = FindFirstFileA((Path::toNativeSeparators(dir) + "\\*").c_str(), &ffd);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return entries;
+    std::unique_ptr<void, decltype(&FindClose)> hFind_deleter(hFind, FindClose);
+    do {
+        if ((ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+            addEntry(ffd.cFileName);
+    } while (FindNextFileA(hFind, &ffd) != FALSE);
+#else
+    std::unique_ptr<DIR, DirCloser> dirp(opendir(dir.c_str()));
+    if (!dirp)
+        return entries;
+    while (const dirent *dir_result = readdir(dirp.get()))
+        addEntry(dir_result->d_name);
+#endif
+
+    return entries;
+}
+
+ResultCache::ResultCache(std::string dir)
+    : mDir(std::move(dir))
+{}
+
+std::string ResultCache::getKey(std::size_t hash, const std::string &sourcefile, const std::string &cfg)
+{
+    // the file name is part of the key since it is contained in the cached findings
+    const std::size_t key = std::hash<std::string> {}(std::to_string(hash) + ':' + cfg + ':' + Path::simplifyPath(sourcefile));
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0') << std::setw(sizeof(std::size_t) * 2) << key;
+    return oss.str();
+}
+
+std::string ResultCache::getEntryFile(const std::string &key) const
+{
+    return Path::join(mDir, key + entryExtension);
+}
+
+bool ResultCache::load(const std::string &key, std::string &content) const
+{
+    const std::string entryFile = getEntryFile(key);
+    std::ifstream fin(entryFile, std::ios::binary);
+    if (!fin.is_open()) {
+        ++s_misses;
+        return false;
+    }
+    std::ostringstream oss;
+    oss << fin.rdbuf();
+    content = oss.str();
+    fin.close();
+
+    // mark entry as recently used
+    utime(entryFile.c_str(), nullptr);
+
+    ++s_hits;
+    return true;
+}
+
+void ResultCache::store(const std::string &key, const std::string &content) const
+{
+    const std::string entryFile = getEntryFile(key);
+    const std::string tempFile = entryFile + '.' + std::to_string(getPid()) + '.' + std::to_string(s_tempFileCounter++) + ".tmp";
+    {
+        std::ofstream fout(tempFile, std::ios::binary);
+        if (!fout.is_open())
+            return;
+        fout << content;
+        if (!fout.good()) {
+            fout.close();
+            std::remove(tempFile.c_str());
+            return;
+        }
+    }
+
+    // rename() is atomic so readers will only ever see complete entries.
+    // it fails on Windows if the entry has been stored by another process in the meantime - it has the same content.
+    if (std::rename(tempFile.c_str(), entryFile.c_str()) != 0) {
+        std::remove(tempFile.c_str());
+        return;
+    }
+    ++s_stores;
+}
+
+std::size_t ResultCache::evict(std::uint64_t maxSize) const
+{
+    std::vector<Entry> entries = getEntries(mDir);
+
+    std::uint64_t size = 0;
+    for (const Entry &e : entries)
+        size += e.size;
+    if (size <= maxSize)
+        return 0;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.mtime < b.mtime;
+    });
+
+    std::size_t removed = 0;
+    for (const Entry &e : entries) {
+        if (size <= maxSize)
+            break;
+        // the entry might already have been removed by another process
+        if (std::remove(e.filename.c_str()) == 0)
+            ++removed;
+        size -= e.size;
+    }
+    s_evictions += removed;
+    return removed;
+}
+
+ResultCache::Statistics ResultCache::getStatistics()
+{
+    return Statistics{s_hits, s_misses, s_stores, s_evictions};
+}
+
+void ResultCache::addStatistics(const Statistics &stats)
+{
+    s_hits += stats.hits;
+    s_misses += stats.misses;
+    s_stores += stats.stores;
+    s_evictions += stats.evictions;
+}
+
+void ResultCache::resetStatistics()
+{
+    s_hits = 0;
+    s_misses = 0;
+    s_stores = 0;
+    s_evictions = 0;
+}
@@ -0,0 +1,80 @@
+/* -*- C++ -*-
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef resultcacheH
+#define resultcacheH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Content addressed cache for analyzer information
+ *
+ * Entries are keyed by the hash of the preprocessed code, the settings, the
+ * Cppcheck version and the name of the analyzed file. The directory can be
+ * shared by several Cppcheck processes (i.e. CI agents) at the same time:
+ * - entries are written to a temporary file and renamed into place
+ * - a hit updates the modification time of the entry, so evict() removes
+ *   the least recently used entries first
+ */
+class CPPCHECKLIB ResultCache {
+public:
+    explicit ResultCache(std::string dir);
+
+    /** Cache statistics of this process */
+    struct Statistics {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t stores;
+        std::size_t evictions;
+    };
+
+    /** Get the key of the entry for the given TU and configuration */
+    static std::string getKey(std::size_t hash, const std::string &sourcefile, const std::string &cfg);
+
+    /** Load the entry @p key. Returns false if there is no such entry. */
+    bool load(const std::string &key, std::string &content) const;
+
+    /** Store @p content as entry @p key */
+    void store(const std::string &key, const std::string &content) const;
+
+    /** Remove the least recently used entries until the cache is no larger than @p maxSize bytes. Returns the number of removed entries. */
+    std::size_t evict(std::uint64_t maxSize) const;
+
+    static Statistics getStatistics();
+    static void addStatistics(const Statistics &stats);
+    static void resetStatistics();
+
+protected:
+    std::string getEntryFile(const std::string &key) const;
+
+private:
+    std::string mDir;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // resultcacheH
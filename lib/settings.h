@@ -142,15 +142,28 @@ public:
     /** @brief Path to the python interpreter to be used to run addons. */
     std::string addonPython;
 
+    /** @brief Execute the Python addons in a long-lived addon server (--addon-server) */
+    bool addonServer{};
+
     /** @brief Analyze all configuration in Visual Studio project. */
     bool analyzeAllVsConfigs{true};
 
+    enum class AnalyzerInfoFormat : std::uint8_t {xml, binary};
+    /** @brief Format of the analyzer information files in the build dir (--analyzer-info-format=<format>) */
+    AnalyzerInfoFormat analyzerInfoFormat = AnalyzerInfoFormat::xml;
+
     /** @brief Paths used as base for conversion to relative paths. */
     std::vector<std::string> basePaths;
 
     /** @brief --cppcheck-build-dir. Always uses / as path separator. No trailing path separator. */
     std::string buildDir;
 
+    /** @brief --cache-dir. Shared result cache directory. Always uses / as path separator. No trailing path separator. */
+    std::string cacheDir;
+
+    /** @brief Maximum size of the result cache in MiB. 0 means unbounded. (--cache-max-size=N) */
+    unsigned int cacheMaxSize = 1024;
+
     /** Is the 'configuration checking' wanted? */
     bool checkConfiguration{};
 
@@ -162,6 +175,10 @@ public:
     /** Check for incomplete info in library files? */
     bool checkLibrary{};
 
+    /** @brief How many threads should run the checks of a single configuration at the
+        same time. Default is 1. (--checks-jobs=N) */
+    unsigned int checksJobs = 1;
+
     /** @brief The maximum time in seconds for the checks of a single file */
     int checksMaxTime{};
 
@@ -192,6 +209,10 @@ public:
     /** @brief include paths excluded from checking the configuration */
     std::set<std::string> configExcludePaths;
 
+    /** @brief How many preprocessor configurations of a single file should be
+        checked at the same time. Default is 1. (--config-jobs=N) */
+    unsigned int configJobs = 1;
+
     /** cppcheck.cfg: Custom product name */
     std::string cppcheckCfgProductName;
 
@@ -255,6 +276,10 @@ public:
     /** @brief Is --dump given? */
     bool dump{};
 
+    enum class DumpFormat : std::uint8_t {xml, binary};
+    /** @brief Format of the dump files (--dump-format=<format>) */
+    DumpFormat dumpFormat = DumpFormat::xml;
+
     /** @brief Do not filter duplicated errors. */
     bool emitDuplicates{};
 
@@ -346,6 +371,9 @@ public:
     /** @brief max template recursion */
     int maxTemplateRecursion = 100;
 
+    /** @brief Report the memory used for the ValueFlow values of each file (--memstats) */
+    bool memstats{};
+
     /** @brief write results (--output-file=&lt;file&gt;) */
     std::string outputFile;
 
@@ -488,6 +516,13 @@ public:
     /** @brief forced includes given by the user */
     std::list<std::string> userIncludes;
 
+    /** @brief How many threads should run the scope-local ValueFlow passes of a single
+        configuration at the same time. Default is 1. (--valueflow-jobs=N) */
+    unsigned int valueFlowJobs = 1;
+
+    /** @brief Report the iterations and the changed tokens of the ValueFlow passes (--valueflow-stats) */
+    bool valueFlowStats{};
+
     // TODO: adjust all options so 0 means "disabled" and -1 "means "unlimited"
     struct ValueFlowOptions
     {
@@ -529,6 +564,10 @@ public:
 
         /** @brief Maximum expression varid depth */
         int maxExprVarIdDepth = 4;
+
+        /** @brief Only analyse the scopes where the values changed in the iterations after
+            the first one (--valueflow-worklist) */
+        bool worklist{};
     };
 
     /** @brief The ValueFlow options */
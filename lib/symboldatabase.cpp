@@ -1841,6 +1841,40 @@ void SymbolDatabase::createSymbolDatabaseExprIds()
     }
 }
 
+void SymbolDatabase::createChangingTokenIndex()
+{
+    mChangingTokens.clear();
+    mHasChangingTokenIndex = false;
+    // the index is searched by the token index so it must be increasing
+    nonneg int index = 0;
+    for (const Token* tok = mTokenizer.list.front(); tok; tok = tok->next()) {
+        if (tok->index() <= index) {
+            mChangingTokens.clear();
+            return;
+        }
+        index = tok->index();
+        if (mayChangeExpression(tok))
+            mChangingTokens.push_back(tok);
+    }
+    mHasChangingTokenIndex = true;
+}
+
+bool SymbolDatabase::getChangingTokens(const Token* start,
+                                       const Token* end,
+                                       std::vector<const Token*>::const_iterator& first,
+                                       std::vector<const Token*>::const_iterator& last) const
+{
+    // tokens that are added later have no index
+    if (!mHasChangingTokenIndex || !start || start->index() == 0 || (end && end->index() == 0))
+        return false;
+    const auto before = [](const Token* tok, nonneg int index) {
+        return tok->index() < index;
+    };
+    first = std::lower_bound(mChangingTokens.cbegin(), mChangingTokens.cend(), start->index(), before);
+    last = end ? std::lower_bound(first, mChangingTokens.cend(), end->index(), before) : mChangingTokens.cend();
+    return true;
+}
+
 // cppcheck-suppress functionConst - has side effects
 void SymbolDatabase::setArrayDimensionsUsingValueFlow()
 {
@@ -4585,6 +4619,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
             }
             outs += "    </scope>\n";
         }
+        writeChunk(out, outs);
     }
     outs += "  </scopes>\n";
 
@@ -4680,6 +4715,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
         outs += bool_to_string(var->isVolatile());
         outs += '\"';
         outs += "/>\n";
+        writeChunk(out, outs);
     }
     outs += "  </variables>\n";
 
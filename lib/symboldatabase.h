@@ -1436,6 +1436,21 @@ public:
     void clangSetVariables(const std::vector<const Variable *> &vars);
     void createSymbolDatabaseExprIds();
 
+    /**
+     * @brief Create the index of the tokens that might change an expression (see mayChangeExpression()).
+     * The AST and the value types must not change afterwards.
+     */
+    void createChangingTokenIndex();
+
+    /**
+     * @brief Get the indexed tokens in the range [start, end) that might change an expression
+     * @return false if there is no index, then all tokens in the range have to be checked
+     */
+    bool getChangingTokens(const Token* start,
+                           const Token* end,
+                           std::vector<const Token*>::const_iterator& first,
+                           std::vector<const Token*>::const_iterator& last) const;
+
     /* returns the opening { if tok points to enum */
     static const Token* isEnumDefinition(const Token* tok);
 
@@ -1521,6 +1536,10 @@ private:
     /** list for missing types */
     std::list<Type> mBlankTypes;
 
+    /** tokens that might change an expression, in the order of the token list */
+    std::vector<const Token*> mChangingTokens;
+    bool mHasChangingTokenIndex{};
+
     ValueType::Sign mDefaultSignedness;
 
     mutable std::map<const Type*, bool> mIsRecordTypeWithoutSideEffectsMap;
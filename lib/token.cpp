@@ -40,6 +40,7 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <new>
 #include <set>
 #include <sstream>
 #include <stack>
@@ -58,19 +59,32 @@ namespace {
     };
 }
 
-const std::list<ValueFlow::Value> Token::mEmptyValueList;
+const std::vector<ValueFlow::Value> Token::mEmptyValueList;
 const std::string Token::mEmptyString;
 
+TokenArena::TokenArena()
+    : tokens(sizeof(Token))
+    , impls(sizeof(Token::Impl))
+{}
+
 Token::Token(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack)
+    : Token(tokenlist, std::move(tokensFrontBack), nullptr)
+{}
+
+Token::Token(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack, TokenArena* arena)
     : mList(tokenlist)
     , mTokensFrontBack(std::move(tokensFrontBack))
-    , mImpl(new Impl)
+    , mStr(&mEmptyString)
+    , mImpl(arena ? new (arena->impls.allocate()) Impl : new Impl)
     , mIsC(mList.isC())
     , mIsCpp(mList.isCPP())
-{}
+    , mArenaAllocated(arena != nullptr)
+{
+    mImpl->mArenaAllocated = mArenaAllocated;
+}
 
 Token::Token(const Token* tok)
-    : Token(tok->mList, const_cast<Token*>(tok)->mTokensFrontBack)
+    : Token(tok->mList, std::make_shared<TokensFrontBack>())
 {
     fileIndex(tok->fileIndex());
     linenr(tok->linenr());
@@ -78,7 +92,45 @@ Token::Token(const Token* tok)
 
 Token::~Token()
 {
-    delete mImpl;
+    destroyImpl(mImpl);
+}
+
+Token* Token::create(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack)
+{
+    TokenArena* arena = tokensFrontBack->arena.get();
+    if (!arena)
+        return new Token(tokenlist, std::move(tokensFrontBack));
+    void* p = arena->tokens.allocate();
+    try {
+        return new (p) Token(tokenlist, std::move(tokensFrontBack), arena);
+    } catch (...) {
+        arena->tokens.deallocate(p);
+        throw;
+    }
+}
+
+void Token::destroy(Token* tok)
+{
+    if (!tok->mArenaAllocated) {
+        delete tok;
+        return;
+    }
+    // the list still holds a reference so the arena outlives the token
+    TokenArena* arena = tok->mTokensFrontBack->arena.get();
+    tok->~Token();
+    arena->tokens.deallocate(tok);
+}
+
+void Token::destroyImpl(Impl* impl)
+{
+    if (!impl)
+        return;
+    if (!impl->mArenaAllocated) {
+        delete impl;
+        return;
+    }
+    impl->~Impl();
+    mTokensFrontBack->arena->impls.deallocate(impl);
 }
 
 /*
@@ -114,8 +166,8 @@ void Token::update_property_info()
     // TODO: clear fIsLong
     isStandardType(false);
 
-    if (!mStr.empty()) {
-        if (mStr == "true" || mStr == "false") {
+    if (!str().empty()) {
+        if (str() == "true" || str() == "false") {
             if (mImpl->mVarId) {
                 if (mIsCpp)
                     throw InternalError(this, "Internal error. VarId set for bool literal.");
@@ -124,24 +176,24 @@ void Token::update_property_info()
             else
                 tokType(eBoolean);
         }
-        else if (isStringLiteral(mStr)) {
+        else if (isStringLiteral(str())) {
             tokType(eString);
-            isLong(isPrefixStringCharLiteral(mStr, '"', "L"));
+            isLong(isPrefixStringCharLiteral(str(), '"', "L"));
         }
-        else if (isCharLiteral(mStr)) {
+        else if (isCharLiteral(str())) {
             tokType(eChar);
-            isLong(isPrefixStringCharLiteral(mStr, '\'', "L"));
+            isLong(isPrefixStringCharLiteral(str(), '\'', "L"));
         }
-        else if (std::isalpha(static_cast<unsigned char>(mStr[0])) || mStr[0] == '_' || mStr[0] == '$') { // Name
+        else if (std::isalpha(static_cast<unsigned char>(str()[0])) || str()[0] == '_' || str()[0] == '$') { // Name
             if (mImpl->mVarId)
                 tokType(eVariable);
-            else if (mList.isKeyword(mStr)) {
+            else if (mList.isKeyword(str())) {
                 tokType(eKeyword);
                 update_property_isStandardType();
                 if (mTokType != eType) // cannot be a control-flow keyword when it is a type
-                    setFlag(fIsControlFlowKeyword, controlFlowKeywords.find(mStr) != controlFlowKeywords.end());
+                    setFlag(fIsControlFlowKeyword, controlFlowKeywords.find(str()) != controlFlowKeywords.end());
             }
-            else if (mStr == "asm") { // TODO: not a keyword
+            else if (str() == "asm") { // TODO: not a keyword
                 tokType(eKeyword);
             }
             else {
@@ -149,43 +201,43 @@ void Token::update_property_info()
                 // some types are not being treated as keywords
                 update_property_isStandardType();
             }
-        } else if (simplecpp::Token::isNumberLike(mStr)) {
-            if ((MathLib::isInt(mStr) || MathLib::isFloat(mStr)) && mStr.find('_') == std::string::npos)
+        } else if (simplecpp::Token::isNumberLike(str())) {
+            if ((MathLib::isInt(str()) || MathLib::isFloat(str())) && str().find('_') == std::string::npos)
                 tokType(eNumber);
             else
                 tokType(eLiteral); // assume it is a user defined literal
-        } else if (mStr == "=" || mStr == "<<=" || mStr == ">>=" ||
-                   (mStr.size() == 2U && mStr[1] == '=' && std::strchr("+-*/%&^|", mStr[0])))
+        } else if (str() == "=" || str() == "<<=" || str() == ">>=" ||
+                   (str().size() == 2U && str()[1] == '=' && std::strchr("+-*/%&^|", str()[0])))
             tokType(eAssignmentOp);
-        else if (mStr.size() == 1 && mStr.find_first_of(",[]()?:") != std::string::npos)
+        else if (str().size() == 1 && str().find_first_of(",[]()?:") != std::string::npos)
             tokType(eExtendedOp);
-        else if (mStr=="<<" || mStr==">>" || (mStr.size()==1 && mStr.find_first_of("+-*/%") != std::string::npos))
+        else if (str()=="<<" || str()==">>" || (str().size()==1 && str().find_first_of("+-*/%") != std::string::npos))
             tokType(eArithmeticalOp);
-        else if (mStr.size() == 1 && mStr.find_first_of("&|^~") != std::string::npos)
+        else if (str().size() == 1 && str().find_first_of("&|^~") != std::string::npos)
             tokType(eBitOp);
-        else if (mStr.size() <= 2 &&
-                 (mStr == "&&" ||
-                  mStr == "||" ||
-                  mStr == "!"))
+        else if (str().size() <= 2 &&
+                 (str() == "&&" ||
+                  str() == "||" ||
+                  str() == "!"))
             tokType(eLogicalOp);
         // TODO: should link check only apply to < and >? Token::link() suggests so
-        else if (mStr.size() <= 2 && !mLink &&
-                 (mStr == "==" ||
-                  mStr == "!=" ||
-                  mStr == "<" ||
-                  mStr == "<=" ||
-                  mStr == ">" ||
-                  mStr == ">="))
+        else if (str().size() <= 2 && !mLink &&
+                 (str() == "==" ||
+                  str() == "!=" ||
+                  str() == "<" ||
+                  str() == "<=" ||
+                  str() == ">" ||
+                  str() == ">="))
             tokType(eComparisonOp);
-        else if (mStr == "<=>")
+        else if (str() == "<=>")
             tokType(eComparisonOp);
-        else if (mStr.size() == 2 &&
-                 (mStr == "++" ||
-                  mStr == "--"))
+        else if (str().size() == 2 &&
+                 (str() == "++" ||
+                  str() == "--"))
             tokType(eIncDecOp);
-        else if (mStr.size() == 1 && (mStr.find_first_of("{}") != std::string::npos || (mLink && mStr.find_first_of("<>") != std::string::npos)))
+        else if (str().size() == 1 && (str().find_first_of("{}") != std::string::npos || (mLink && str().find_first_of("<>") != std::string::npos)))
             tokType(eBracket);
-        else if (mStr == "...")
+        else if (str() == "...")
             tokType(eEllipsis);
         else
             tokType(eOther);
@@ -217,10 +269,10 @@ bool Token::isStandardType(const std::string& s)
 
 void Token::update_property_isStandardType()
 {
-    if (mStr.size() < 3 || mStr.size() > 7)
+    if (str().size() < 3 || str().size() > 7)
         return;
 
-    if (isStandardType(mStr)) {
+    if (isStandardType(str())) {
         isStandardType(true);
         tokType(eType);
     }
@@ -230,26 +282,57 @@ bool Token::isUpperCaseName() const
 {
     if (!isName())
         return false;
-    return std::none_of(mStr.begin(), mStr.end(), [](char c) {
+    return std::none_of(str().begin(), str().end(), [](char c) {
         return std::islower(c);
     });
 }
 
+void Token::str(const std::string& s)
+{
+    mStr = mTokensFrontBack->strings.intern(s);
+    mImpl->mVarId = 0;
+
+    update_property_info();
+}
+
+void Token::str(std::string&& s)
+{
+    mStr = mTokensFrontBack->strings.intern(std::move(s));
+    mImpl->mVarId = 0;
+
+    update_property_info();
+}
+
+const std::string* Token::libraryFunctionName(const Library& library) const
+{
+    if (mTokensFrontBack->functionNamesLibrary != &library)
+        return nullptr;
+    return mImpl->mLibraryFunctionName;
+}
+
+void Token::libraryFunctionName(const Library& library, const std::string& name)
+{
+    mTokensFrontBack->functionNamesLibrary = &library;
+    mImpl->mLibraryFunctionName = mTokensFrontBack->strings.intern(name);
+}
+
 void Token::concatStr(std::string const& b)
 {
-    mStr.pop_back();
-    mStr.append(getStringLiteral(b) + "\"");
+    std::string s = str();
+    s.pop_back();
+    s.append(getStringLiteral(b) + "\"");
 
     if (isCChar() && isStringLiteral(b) && b[0] != '"') {
-        mStr.insert(0, b.substr(0, b.find('"')));
+        s.insert(0, b.substr(0, b.find('"')));
     }
+    mStr = mTokensFrontBack->strings.intern(std::move(s));
     update_property_info();
 }
 
 std::string Token::strValue() const
 {
     assert(mTokType == eString);
-    std::string ret(getStringLiteral(mStr));
+    std::string ret(getStringLiteral(str()));
     std::string::size_type pos = 0U;
     while ((pos = ret.find('\\', pos)) != std::string::npos) {
         ret.erase(pos,1U);
@@ -278,7 +361,7 @@ void Token::deleteNext(nonneg int count)
             n->mLink->link(nullptr);
 
         mNext = n->next();
-        delete n;
+        destroy(n);
         --count;
     }
 
@@ -298,7 +381,7 @@ void Token::deletePrevious(nonneg int count)
             p->mLink->link(nullptr);
 
         mPrevious = p->previous();
-        delete p;
+        destroy(p);
         --count;
     }
 
@@ -339,7 +422,7 @@ void Token::takeData(Token *fromToken)
     mStr = fromToken->mStr;
     tokType(fromToken->mTokType);
     mFlags = fromToken->mFlags;
-    delete mImpl;
+    destroyImpl(mImpl);
     mImpl = fromToken->mImpl;
     fromToken->mImpl = nullptr;
     if (mImpl->mTemplateSimplifierPointers)
@@ -399,7 +482,7 @@ void Token::replace(Token *replaceThis, Token *start, Token *end)
         tok->mImpl->mProgressValue = replaceThis->mImpl->mProgressValue;
 
     // Delete old token, which is replaced
-    delete replaceThis;
+    destroy(replaceThis);
 }
 
 /**
@@ -620,7 +703,7 @@ bool Token::simpleMatch(const Token *tok, const char pattern[], size_t pattern_l
     while (*current) {
         const std::size_t length = next - current;
 
-        if (!tok || length != tok->mStr.length() || std::strncmp(current, tok->mStr.c_str(), length) != 0)
+        if (!tok || length != tok->str().length() || std::strncmp(current, tok->str().c_str(), length) != 0)
             return false;
 
         current = next;
@@ -874,7 +957,7 @@ static bool isOperator(const Token *tok)
 
 const Token * Token::findClosingBracket() const
 {
-    if (mStr != "<")
+    if (str() != "<")
         return nullptr;
 
     if (!mPrevious)
@@ -939,7 +1022,7 @@ Token * Token::findClosingBracket()
 
 const Token * Token::findOpeningBracket() const
 {
-    if (mStr != ">")
+    if (str() != ">")
         return nullptr;
 
     const Token *opening = nullptr;
@@ -1063,8 +1146,10 @@ void Token::function(const Function *f)
 Token* Token::insertToken(const std::string& tokenStr, bool prepend)
 {
     Token *newToken;
-    if (mStr.empty())
+    if (str().empty())
         newToken = this;
+    else if (mArenaAllocated)
+        newToken = create(mList, mTokensFrontBack);
     else
         newToken = new Token(mList, mTokensFrontBack);
     newToken->str(tokenStr);
@@ -1283,15 +1368,15 @@ std::string Token::stringify(const stringifyOptions& options) const
     }
     if (options.macro && isExpandedMacro())
         ret += '$';
-    if (isName() && mStr.find(' ') != std::string::npos) {
-        for (const char i : mStr) {
+    if (isName() && str().find(' ') != std::string::npos) {
+        for (const char i : str()) {
             if (i != ' ')
                 ret += i;
         }
-    } else if (mStr[0] != '\"' || mStr.find('\0') == std::string::npos)
-        ret += mStr;
+    } else if (str()[0] != '\"' || str().find('\0') == std::string::npos)
+        ret += str();
     else {
-        for (const char i : mStr) {
+        for (const char i : str()) {
             if (i == '\0')
                 ret += "\\0";
             else
@@ -1699,7 +1784,7 @@ void Token::astStringVerboseRecursive(std::string& ret, const nonneg int indent1
 {
     if (isExpandedMacro())
         ret += '$';
-    ret += mStr;
+    ret += str();
     if (mImpl->mValueType)
         ret += " \'" + mImpl->mValueType->str() + '\'';
     if (function()) {
@@ -1917,6 +2002,7 @@ void Token::printValueFlow(const std::vector<std::string>& files, bool xml, std:
             outs += "}\n";
         else
             outs += '\n';
+        writeChunk(out, outs);
     }
     if (xml)
         outs += "  </valueflow>\n";
@@ -2024,7 +2110,7 @@ static bool isAdjacent(const ValueFlow::Value& x, const ValueFlow::Value& y)
     return std::abs(x.intvalue - y.intvalue) == 1;
 }
 
-static bool removePointValue(std::list<ValueFlow::Value>& values, std::list<ValueFlow::Value>::iterator& x)
+static bool removePointValue(std::vector<ValueFlow::Value>& values, std::vector<ValueFlow::Value>::iterator& x)
 {
     const bool isPoint = x->bound == ValueFlow::Value::Bound::Point;
     if (!isPoint)
@@ -2034,7 +2120,7 @@ static bool removePointValue(std::list<ValueFlow::Value>& values, std::list<Valu
     return isPoint;
 }
 
-static bool removeContradiction(std::list<ValueFlow::Value>& values)
+static bool removeContradiction(std::vector<ValueFlow::Value>& values)
 {
     bool result = false;
     for (auto itx = values.begin(); itx != values.end(); ++itx) {
@@ -2055,7 +2141,7 @@ static bool removeContradiction(std::list<ValueFlow::Value>& values)
             if (itx->isSymbolicValue() && !ValueFlow::Value::sameToken(itx->tokvalue, ity->tokvalue))
                 continue;
             if (!itx->equalValue(*ity)) {
-                auto compare = [](const std::list<ValueFlow::Value>::const_iterator& x, const std::list<ValueFlow::Value>::const_iterator& y) {
+                auto compare = [](const std::vector<ValueFlow::Value>::const_iterator& x, const std::vector<ValueFlow::Value>::const_iterator& y) {
                     return x->compareValue(*y, less{});
                 };
                 auto itMax = std::max(itx, ity, compare);
@@ -2073,20 +2159,21 @@ static bool removeContradiction(std::list<ValueFlow::Value>& values)
             }
             const bool removex = !itx->isImpossible() || ity->isKnown();
             const bool removey = !ity->isImpossible() || itx->isKnown();
+            // ity is behind itx so it is removed first to keep itx valid
             if (itx->bound == ity->bound) {
-                if (removex)
-                    values.erase(itx);
                 if (removey)
                     values.erase(ity);
+                if (removex)
+                    values.erase(itx);
                 // itx and ity are invalidated
                 return true;
             }
             result = removex || removey;
             bool bail = false;
-            if (removex && removePointValue(values, itx))
-                bail = true;
             if (removey && removePointValue(values, ity))
                 bail = true;
+            if (removex && removePointValue(values, itx))
+                bail = true;
             if (bail)
                 return true;
         }
@@ -2094,63 +2181,70 @@ static bool removeContradiction(std::list<ValueFlow::Value>& values)
     return result;
 }
 
-using ValueIterator = std::list<ValueFlow::Value>::iterator;
-
 template<class Iterator>
 // NOLINTNEXTLINE(performance-unnecessary-value-param) - false positive
-static ValueIterator removeAdjacentValues(std::list<ValueFlow::Value>& values, ValueIterator x, Iterator start, Iterator last)
+static std::size_t removeAdjacentValues(std::vector<ValueFlow::Value>& values, std::size_t x, Iterator start, Iterator last)
 {
-    if (!isAdjacent(*x, **start))
-        return std::next(x);
-    auto it = std::adjacent_find(start, last, [](ValueIterator x, ValueIterator y) {
-        return !isAdjacent(*x, *y);
+    if (!isAdjacent(values[x], values[*start]))
+        return x + 1;
+    auto it = std::adjacent_find(start, last, [&values](std::size_t a, std::size_t b) {
+        return !isAdjacent(values[a], values[b]);
     });
     if (it == last)
         it--;
-    (*it)->bound = x->bound;
-    std::for_each(std::move(start), std::move(it), [&](ValueIterator y) {
-        values.erase(y);
-    });
-    return values.erase(x);
+    values[*it].bound = values[x].bound;
+    std::vector<std::size_t> removed(start, it);
+    removed.push_back(x);
+    std::sort(removed.begin(), removed.end(), std::greater<std::size_t>{});
+    std::size_t next = x;
+    for (const std::size_t y : removed) {
+        values.erase(values.begin() + y);
+        if (y < x)
+            --next;
+    }
+    // the value after x
+    return next;
 }
 
-static void mergeAdjacent(std::list<ValueFlow::Value>& values)
+static void mergeAdjacent(std::vector<ValueFlow::Value>& values)
 {
-    for (auto x = values.begin(); x != values.end();) {
-        if (x->isNonValue()) {
+    for (std::size_t x = 0; x < values.size();) {
+        const ValueFlow::Value& xv = values[x];
+        if (xv.isNonValue()) {
             x++;
             continue;
         }
-        if (x->bound == ValueFlow::Value::Bound::Point) {
+        if (xv.bound == ValueFlow::Value::Bound::Point) {
             x++;
             continue;
         }
-        std::vector<ValueIterator> adjValues;
-        for (auto y = values.begin(); y != values.end(); y++) {
+        std::vector<std::size_t> adjValues;
+        for (std::size_t y = 0; y < values.size(); y++) {
             if (x == y)
                 continue;
-            if (y->isNonValue())
+            const ValueFlow::Value& yv = values[y];
+            if (yv.isNonValue())
                 continue;
-            if (x->valueType != y->valueType)
+            if (xv.valueType != yv.valueType)
                 continue;
-            if (x->valueKind != y->valueKind)
+            if (xv.valueKind != yv.valueKind)
                 continue;
-            if (x->isSymbolicValue() && !ValueFlow::Value::sameToken(x->tokvalue, y->tokvalue))
+            if (xv.isSymbolicValue() && !ValueFlow::Value::sameToken(xv.tokvalue, yv.tokvalue))
                 continue;
-            if (x->bound != y->bound) {
-                if (y->bound != ValueFlow::Value::Bound::Point && isAdjacent(*x, *y)) {
+            if (xv.bound != yv.bound) {
+                if (yv.bound != ValueFlow::Value::Bound::Point && isAdjacent(xv, yv)) {
                     adjValues.clear();
                     break;
                 }
                 // No adjacent points for floating points
-                if (x->valueType == ValueFlow::Value::ValueType::FLOAT)
+                if (xv.valueType == ValueFlow::Value::ValueType::FLOAT)
                     continue;
-                if (y->bound != ValueFlow::Value::Bound::Point)
+                if (yv.bound != ValueFlow::Value::Bound::Point)
                     continue;
             }
-            if (x->bound == ValueFlow::Value::Bound::Lower && !y->compareValue(*x, less{}))
+            if (xv.bound == ValueFlow::Value::Bound::Lower && !yv.compareValue(xv, less{}))
                 continue;
-            if (x->bound == ValueFlow::Value::Bound::Upper && !x->compareValue(*y, less{}))
+            if (xv.bound == ValueFlow::Value::Bound::Upper && !xv.compareValue(yv, less{}))
                 continue;
             adjValues.push_back(y);
         }
@@ -2158,47 +2252,57 @@ static void mergeAdjacent(std::list<ValueFlow::Value>& values)
             x++;
             continue;
         }
-        std::sort(adjValues.begin(), adjValues.end(), [&values](ValueIterator xx, ValueIterator yy) {
-            (void)values;
-            assert(xx != values.end() && yy != values.end());
-            return xx->compareValue(*yy, less{});
+        std::sort(adjValues.begin(), adjValues.end(), [&values](std::size_t xx, std::size_t yy) {
+            assert(xx < values.size() && yy < values.size());
+            return values[xx].compareValue(values[yy], less{});
         });
-        if (x->bound == ValueFlow::Value::Bound::Lower)
+        if (xv.bound == ValueFlow::Value::Bound::Lower)
             x = removeAdjacentValues(values, x, adjValues.rbegin(), adjValues.rend());
-        else if (x->bound == ValueFlow::Value::Bound::Upper)
+        else if (xv.bound == ValueFlow::Value::Bound::Upper)
             x = removeAdjacentValues(values, x, adjValues.begin(), adjValues.end());
     }
 }
 
-static void removeOverlaps(std::list<ValueFlow::Value>& values)
+static bool isOverlap(const ValueFlow::Value& x, const ValueFlow::Value& y)
 {
-    for (const ValueFlow::Value& x : values) {
-        if (x.isNonValue())
+    if (y.isNonValue())
+        return false;
+    if (x.valueType != y.valueType)
+        return false;
+    if (x.valueKind != y.valueKind)
+        return false;
+    // TODO: Remove points covered in a lower or upper bound
+    // TODO: Remove lower or upper bound already covered by a lower and upper bound
+    if (!x.equalValue(y))
+        return false;
+    if (x.bound != y.bound)
+        return false;
+    return true;
+}
+
+static void removeOverlaps(std::vector<ValueFlow::Value>& values)
+{
+    for (std::size_t x = 0; x < values.size(); ++x) {
+        if (values[x].isNonValue())
             continue;
-        values.remove_if([&](const ValueFlow::Value& y) {
-            if (y.isNonValue())
-                return false;
-            if (&x == &y)
-                return false;
-            if (x.valueType != y.valueType)
-                return false;
-            if (x.valueKind != y.valueKind)
-                return false;
-            // TODO: Remove points covered in a lower or upper bound
-            // TODO: Remove lower or upper bound already covered by a lower and upper bound
-            if (!x.equalValue(y))
-                return false;
-            if (x.bound != y.bound)
-                return false;
-            return true;
-        });
+        std::vector<std::size_t> removed;
+        for (std::size_t y = values.size(); y > 0; --y) {
+            if (y - 1 != x && isOverlap(values[x], values[y - 1]))
+                removed.push_back(y - 1);
+        }
+        // removed is in descending order
+        for (const std::size_t y : removed) {
+            values.erase(values.begin() + y);
+            if (y < x)
+                --x;
+        }
     }
     mergeAdjacent(values);
 }
 
 // Removing contradictions is an NP-hard problem. Instead we run multiple
 // passes to try to catch most contradictions
-static void removeContradictions(std::list<ValueFlow::Value>& values)
+static void removeContradictions(std::vector<ValueFlow::Value>& values)
 {
     removeOverlaps(values);
     for (int i = 0; i < 4; i++) {
@@ -2222,9 +2326,9 @@ bool Token::addValue(const ValueFlow::Value &value)
 {
     if (value.isKnown() && mImpl->mValues) {
         // Clear all other values of the same type since value is known
-        mImpl->mValues->remove_if([&](const ValueFlow::Value& x) {
+        mImpl->mValues->erase(std::remove_if(mImpl->mValues->begin(), mImpl->mValues->end(), [&](const ValueFlow::Value& x) {
             return sameValueType(x, value);
-        });
+        }), mImpl->mValues->end());
     }
 
     // Don't add a value if its already known
@@ -2280,7 +2384,7 @@ bool Token::addValue(const ValueFlow::Value &value)
             if (v.varId == 0)
                 v.varId = mImpl->mVarId;
             if (v.isKnown() && v.isIntValue())
-                mImpl->mValues->push_front(std::move(v));
+                mImpl->mValues->insert(mImpl->mValues->begin(), std::move(v));
             else
                 mImpl->mValues->push_back(std::move(v));
         }
@@ -2288,7 +2392,7 @@ bool Token::addValue(const ValueFlow::Value &value)
         ValueFlow::Value v(value);
         if (v.varId == 0)
             v.varId = mImpl->mVarId;
-        mImpl->mValues = new std::list<ValueFlow::Value>;
+        mImpl->mValues = new std::vector<ValueFlow::Value>;
         mImpl->mValues->push_back(std::move(v));
     }
 
@@ -2579,7 +2683,7 @@ const ValueFlow::Value* Token::getValue(const MathLib::bigint val) const
 }
 
 template<class Compare>
-static const ValueFlow::Value* getCompareValue(const std::list<ValueFlow::Value>& values,
+static const ValueFlow::Value* getCompareValue(const std::vector<ValueFlow::Value>& values,
                                                bool condition,
                                                MathLib::bigint path,
                                                Compare compare)
@@ -46,6 +46,7 @@
 
 struct Enumerator;
 class Function;
+class Library;
 class Scope;
 class Settings;
 class Type;
@@ -53,6 +54,7 @@ class ValueType;
 class Variable;
 class ConstTokenRange;
 class Token;
+struct TokenArena;
 struct TokensFrontBack;
 class TokenList;
 struct ReferenceToken;
@@ -133,11 +135,14 @@ private:
         // If this token came from a macro replacement list, this is the name of that macro
         std::string* mMacroName{};
 
+        // Name of the library function this token calls, memoized after the simplification (interned)
+        const std::string* mLibraryFunctionName{};
+
         // ValueType
         ValueType* mValueType{};
 
         // ValueFlow
-        std::list<ValueFlow::Value>* mValues{};
+        std::vector<ValueFlow::Value>* mValues{};
 
         // Pointer to a template in the template simplifier
         std::set<TemplateSimplifier::TokenAndName*>* mTemplateSimplifierPointers{};
@@ -174,6 +179,9 @@ private:
 
         std::int8_t mMutableExpr{-1};
 
+        /** the memory was taken from the TokenArena of the list */
+        bool mArenaAllocated{};
+
         void setCppcheckAttribute(CppcheckAttributesType attrType, MathLib::bigint value);
         bool getCppcheckAttribute(CppcheckAttributesType attrType, MathLib::bigint &value) const;
 
@@ -187,6 +195,13 @@ private:
     const TokenList& mList;
     std::shared_ptr<TokensFrontBack> mTokensFrontBack;
 
+    friend struct TokenArena;
+
+    Token(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack, TokenArena* arena);
+
+    /** Release the implementation data, either to the arena of the list or to the heap */
+    void destroyImpl(Impl* impl);
+
     static const std::string mEmptyString;
 
 public:
@@ -209,15 +224,19 @@ public:
     explicit Token(const Token *tok);
     ~Token();
 
-    ConstTokenRange until(const Token * t) const;
+    /**
+     * Create a token for a list. The memory is taken from the arena of the list if it has one.
+     * Such a token must be released with destroy().
+     */
+    static Token* create(const TokenList& tokenlist, std::shared_ptr<TokensFrontBack> tokensFrontBack);
 
-    template<typename T>
-    void str(T&& s) {
-        mStr = s;
-        mImpl->mVarId = 0;
+    /** Release a token created with create() or new */
+    static void destroy(Token* tok);
 
-        update_property_info();
-    }
+    ConstTokenRange until(const Token * t) const;
+
+    void str(const std::string& s);
+    void str(std::string&& s);
 
     /**
      * Concatenate two (quoted) strings. Automatically cuts of the last/first character.
@@ -226,7 +245,7 @@ public:
     void concatStr(std::string const& b);
 
     const std::string &str() const {
-        return mStr;
+        return *mStr;
     }
 
     /**
@@ -278,7 +297,7 @@ public:
     const std::string &strAt(int idx) const
     {
         const Token *tok = this->tokAt(idx);
-        return tok ? tok->mStr : mEmptyString;
+        return tok ? *tok->mStr : mEmptyString;
     }
 
     /**
@@ -458,7 +477,7 @@ public:
         return astOperand1() != nullptr && astOperand2() != nullptr;
     }
     bool isUnaryOp(const std::string &s) const {
-        return s == mStr && astOperand1() != nullptr && astOperand2() == nullptr;
+        return s == *mStr && astOperand1() != nullptr && astOperand2() == nullptr;
     }
     bool isUnaryPreOp() const;
 
@@ -804,27 +823,27 @@ public:
     }
 
     bool isUtf8() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "u8")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "u8")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "u8")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "u8")));
     }
 
     bool isUtf16() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "u")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "u")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "u")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "u")));
     }
 
     bool isUtf32() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "U")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "U")));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "U")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "U")));
     }
 
     bool isCChar() const {
-        return (((mTokType == eString) && isPrefixStringCharLiteral(mStr, '"', "")) ||
-                ((mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "") && (replaceEscapeSequences(getCharLiteral(mStr)).size() == 1)));
+        return (((mTokType == eString) && isPrefixStringCharLiteral(*mStr, '"', "")) ||
+                ((mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "") && (replaceEscapeSequences(getCharLiteral(*mStr)).size() == 1)));
     }
 
     bool isCMultiChar() const {
-        return (mTokType == eChar) && isPrefixStringCharLiteral(mStr, '\'', "") && (replaceEscapeSequences(getCharLiteral(mStr)).size() > 1);
+        return (mTokType == eChar) && isPrefixStringCharLiteral(*mStr, '\'', "") && (replaceEscapeSequences(getCharLiteral(*mStr)).size() > 1);
     }
 
     /**
@@ -868,6 +887,13 @@ public:
             *mImpl->mMacroName = std::move(name);
     }
 
+    /**
+     * @return the name @p library returns in Library::getFunctionName() for this token
+     * when it has been memoized by the tokenizer, otherwise nullptr
+     */
+    const std::string* libraryFunctionName(const Library& library) const;
+    void libraryFunctionName(const Library& library, const std::string& name);
+
     template<size_t count>
     static const Token *findsimplematch(const Token * const startTok, const char (&pattern)[count]) {
         return findsimplematch(startTok, pattern, count-1);
@@ -1184,7 +1210,7 @@ public:
             return;
 
         mLink = linkToToken;
-        if (mStr == "<" || mStr == ">")
+        if (*mStr == "<" || *mStr == ">")
             update_property_info();
     }
 
@@ -1366,7 +1392,7 @@ public:
         return mImpl->mOriginalName ? *mImpl->mOriginalName : mEmptyString;
     }
 
-    const std::list<ValueFlow::Value>& values() const {
+    const std::vector<ValueFlow::Value>& values() const {
         return mImpl->mValues ? *mImpl->mValues : mEmptyValueList;
     }
 
@@ -1423,7 +1449,7 @@ public:
 
     void removeValues(std::function<bool(const ValueFlow::Value &)> pred) {
         if (mImpl->mValues)
-            mImpl->mValues->remove_if(std::move(pred));
+            mImpl->mValues->erase(std::remove_if(mImpl->mValues->begin(), mImpl->mValues->end(), std::move(pred)), mImpl->mValues->end());
     }
 
     nonneg int index() const {
@@ -1433,7 +1459,7 @@ public:
     void assignIndexes();
 
 private:
-    static const std::list<ValueFlow::Value> mEmptyValueList;
+    static const std::vector<ValueFlow::Value> mEmptyValueList;
 
     void next(Token *nextToken) {
         mNext = nextToken;
@@ -1463,7 +1489,8 @@ private:
     RET_NONNULL Token* insertToken(const std::string& tokenStr, const std::string& originalNameStr, bool prepend);
     RET_NONNULL Token* insertToken(const std::string& tokenStr, const std::string& originalNameStr, const std::string& macroNameStr, bool prepend);
 
-    std::string mStr;
+    /** interned in the string table of the list */
+    const std::string* mStr;
 
     Token* mNext{};
     Token* mPrevious{};
@@ -1563,6 +1590,8 @@ private:
     // cppcheck-suppress premium-misra-cpp-2023-12.2.1
     bool mIsC : 1;
     bool mIsCpp : 1;
+    /** the memory was taken from the TokenArena of the list */
+    bool mArenaAllocated : 1;
 
 public:
     void astOperand1(Token *tok);
@@ -1659,7 +1688,7 @@ public:
             ret = mImpl->mAstOperand1->astString(sep);
         if (mImpl->mAstOperand2)
             ret += mImpl->mAstOperand2->astString(sep);
-        return ret + sep + mStr;
+        return ret + sep + *mStr;
     }
 
     std::string astStringVerbose() const;
@@ -3579,11 +3579,21 @@ bool Tokenizer::simplifyTokens1(const std::string &configuration, int fileIndex)
     Timer::run("Tokenizer::simplifyTokens1::setValueType", mTimerResults, [&]() {
         mSymbolDatabase->setValueTypeInTokenList(false);
         mSymbolDatabase->setValueTypeInTokenList(true);
+        mSymbolDatabase->createChangingTokenIndex();
     });
 
     if (!mSettings.buildDir.empty())
         Summaries::create(*this, configuration, fileIndex);
 
+    // ValueFlow and the checks ask the library about the same calls many times. The AST and the value types
+    // do not change anymore so the names are memoized.
+    Timer::run("Tokenizer::simplifyTokens1::libraryFunctionNames", mTimerResults, [&]() {
+        for (Token *tok = list.front(); tok; tok = tok->next()) {
+            if (tok->isName())
+                tok->libraryFunctionName(mSettings.library, mSettings.library.getFunctionName(tok));
+        }
+    });
+
     // TODO: apply this through Settings::ValueFlowOptions
     // TODO: do not run valueflow if no checks are being performed at all - e.g. unusedFunctions only
     // TODO: log message when this is active?
@@ -6200,6 +6210,7 @@ void Tokenizer::dump(std::ostream &out) const
         }
         outs += "    </directive>";
         outs += '\n';
+        writeChunk(out, outs);
     }
     outs += "  </directivelist>";
     outs += '\n';
@@ -6374,6 +6385,7 @@ void Tokenizer::dump(std::ostream &out) const
 
         outs += "/>";
         outs += '\n';
+        writeChunk(out, outs);
     }
     outs += "  </tokenlist>";
     outs += '\n';
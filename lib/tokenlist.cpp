@@ -30,10 +30,12 @@
 #include "settings.h"
 #include "standards.h"
 #include "token.h"
+#include "vfvalue.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
@@ -52,12 +54,46 @@
 static constexpr int AST_MAX_DEPTH = 150;
 
 
+FixedSizePool::FixedSizePool(std::size_t blockSize)
+    : mBlockSize(std::max(blockSize, sizeof(FreeBlock)))
+{
+    // keep every block suitably aligned for any object
+    const std::size_t alignment = alignof(std::max_align_t);
+    mBlockSize = (mBlockSize + alignment - 1) / alignment * alignment;
+}
+
+void FixedSizePool::addChunk()
+{
+    // start small since many lists only hold a few tokens and then double up to 64KiB chunks
+    std::size_t blocks = mChunks.empty() ? 16 : (static_cast<std::size_t>(mEnd - mChunks.back().get()) / mBlockSize) * 2;
+    blocks = std::max<std::size_t>(1, std::min(blocks, 64 * 1024 / mBlockSize));
+    const std::size_t size = blocks * mBlockSize;
+    mChunks.emplace_back(new char[size]);
+    mPos = mChunks.back().get();
+    mEnd = mPos + size;
+    mCapacity += size;
+}
+
+const std::string* TokenStringTable::intern(const std::string& s)
+{
+    const auto it = mStrings.find(s);
+    if (it != mStrings.end())
+        return &*it;
+    return &*mStrings.insert(s).first;
+}
+
+const std::string* TokenStringTable::intern(std::string&& s)
+{
+    return &*mStrings.insert(std::move(s)).first;
+}
+
 TokenList::TokenList(const Settings& settings, Standards::Language lang)
     : mTokensFrontBack(new TokensFrontBack)
     , mSettings(settings)
 {
     assert(lang != Standards::Language::None);
     mLang = lang;
+    mTokensFrontBack->arena.reset(new TokenArena);
 }
 
 TokenList::~TokenList()
@@ -119,7 +155,7 @@ void TokenList::deleteTokens(Token *tok)
 {
     while (tok) {
         Token *next = tok->next();
-        delete tok;
+        Token::destroy(tok);
         tok = next;
     }
 }
@@ -151,7 +187,7 @@ void TokenList::addtoken(const std::string& str, const nonneg int lineno, const
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(str);
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(str);
     }
@@ -169,7 +205,7 @@ void TokenList::addtoken(const std::string& str, const Token *locationTok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(str);
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(str);
     }
@@ -187,7 +223,7 @@ void TokenList::addtoken(const Token * tok, const nonneg int lineno, const nonne
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -209,7 +245,7 @@ void TokenList::addtoken(const Token *tok, const Token *locationTok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -231,7 +267,7 @@ void TokenList::addtoken(const Token *tok)
     if (mTokensFrontBack->back) {
         mTokensFrontBack->back->insertToken(tok->str(), tok->originalName(), tok->getMacroName());
     } else {
-        mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+        mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
         mTokensFrontBack->back = mTokensFrontBack->front;
         mTokensFrontBack->back->str(tok->str());
         if (!tok->originalName().empty())
@@ -391,7 +427,7 @@ void TokenList::createTokens(simplecpp::TokenList&& tokenList)
         if (mTokensFrontBack->back) {
             mTokensFrontBack->back->insertToken(str);
         } else {
-            mTokensFrontBack->front = new Token(*this, mTokensFrontBack);
+            mTokensFrontBack->front = Token::create(*this, mTokensFrontBack);
             mTokensFrontBack->back = mTokensFrontBack->front;
             mTokensFrontBack->back->str(str);
         }
@@ -430,6 +466,32 @@ std::size_t TokenList::calculateHash() const
     return (std::hash<std::string>{})(hashData);
 }
 
+TokenList::ValueStats TokenList::valueStats() const
+{
+    // the error paths are shared between the copies of a value so each one is only counted once
+    std::unordered_set<const ErrorPath*> paths;
+    const auto addPath = [&](ValueStats& stats, const ValueFlow::SharedErrorPath& path) {
+        if (path.empty() || !paths.insert(&path.get()).second)
+            return;
+        // a list node holds the item and two links
+        stats.bytes += sizeof(ErrorPath) + path.size() * (sizeof(ErrorPathItem) + 2 * sizeof(void*));
+        for (const ErrorPathItem& item : path)
+            stats.bytes += item.second.capacity();
+    };
+
+    ValueStats stats;
+    for (const Token* tok = front(); tok; tok = tok->next()) {
+        const std::vector<ValueFlow::Value>& values = tok->values();
+        stats.values += values.size();
+        stats.bytes += values.capacity() * sizeof(ValueFlow::Value);
+        for (const ValueFlow::Value& value : values) {
+            addPath(stats, value.errorPath);
+            addPath(stats, value.debugPath);
+        }
+    }
+    return stats;
+}
+
 
 //---------------------------------------------------------------------------
 
@@ -28,8 +28,10 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+class Library;
 class Token;
 class Settings;
 
@@ -40,12 +42,100 @@ namespace simplecpp {
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief Allocator for memory blocks of a single size.
+ * The blocks are carved out of chunks that grow geometrically. Released blocks are
+ * kept in a free list and handed out again. All chunks are freed when the pool is
+ * destroyed. It is not thread-safe.
+ */
+class CPPCHECKLIB FixedSizePool {
+public:
+    explicit FixedSizePool(std::size_t blockSize);
+
+    FixedSizePool(const FixedSizePool &) = delete;
+    FixedSizePool &operator=(const FixedSizePool &) = delete;
+
+    void* allocate() {
+        if (mFreeList) {
+            FreeBlock* block = mFreeList;
+            mFreeList = block->next;
+            return block;
+        }
+        if (mPos == mEnd)
+            addChunk();
+        void* p = mPos;
+        mPos += mBlockSize;
+        return p;
+    }
+
+    void deallocate(void* p) {
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = mFreeList;
+        mFreeList = block;
+    }
+
+    /** @return the number of bytes allocated for the chunks */
+    std::size_t capacity() const {
+        return mCapacity;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void addChunk();
+
+    std::size_t mBlockSize;
+    std::size_t mCapacity{};
+    std::vector<std::unique_ptr<char[]>> mChunks;
+    char* mPos{};
+    char* mEnd{};
+    FreeBlock* mFreeList{};
+};
+
+/**
+ * @brief Memory for the tokens of a TokenList and their implementation data.
+ * The tokens deleted during the simplifications are recycled for new tokens.
+ */
+struct CPPCHECKLIB TokenArena {
+    TokenArena();
+
+    FixedSizePool tokens;
+    FixedSizePool impls;
+};
+
+/**
+ * @brief Interned strings of the tokens of a list.
+ * Every distinct string is stored once and the tokens point to it. The strings stay
+ * valid until the table is destroyed. It is not thread-safe.
+ */
+class CPPCHECKLIB TokenStringTable {
+public:
+    const std::string* intern(const std::string& s);
+    const std::string* intern(std::string&& s);
+
+    /** @return the number of distinct strings */
+    std::size_t size() const {
+        return mStrings.size();
+    }
+
+private:
+    std::unordered_set<std::string> mStrings;
+};
+
 /**
  * @brief This struct stores pointers to the front and back tokens of the list this token is in.
  */
 struct TokensFrontBack {
     Token *front{};
     Token* back{};
+    /** the strings of the tokens */
+    TokenStringTable strings;
+    /** memory for the tokens created by the TokenList - not set when the tokens are created stand-alone */
+    std::unique_ptr<TokenArena> arena;
+    /** the library used for the memoized library function names of the tokens */
+    const Library* functionNamesLibrary{};
 };
 
 class CPPCHECKLIB TokenList {
@@ -166,6 +256,17 @@ public:
      */
     std::size_t calculateHash() const;
 
+    /** @brief Memory used for the ValueFlow values of the tokens */
+    struct ValueStats {
+        /** number of values */
+        std::size_t values{};
+        /** bytes allocated for the values and their distinct error paths */
+        std::size_t bytes{};
+    };
+
+    /** Collect the memory used for the ValueFlow values (--memstats) */
+    ValueStats valueStats() const;
+
     /**
      * Create abstract syntax tree.
      * @throws InternalError thrown if encountering an infinite loop in AST creation
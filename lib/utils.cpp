@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <ostream>
 #include <stack>
 #include <utility>
 
@@ -198,3 +199,11 @@ std::vector<std::string> splitString(const std::string& str, char sep)
     }
     return l;
 }
+
+void writeChunk(std::ostream &out, std::string &buffer, std::size_t size)
+{
+    if (buffer.size() < size)
+        return;
+    out << buffer;
+    buffer.clear();
+}
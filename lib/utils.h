@@ -30,6 +30,7 @@
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <iosfwd>
 #include <limits>
 #include <stdexcept>
 #include <string>
@@ -431,6 +432,16 @@ static inline T* empty_if_null(T* p)
  */
 CPPCHECKLIB std::vector<std::string> splitString(const std::string& str, char sep);
 
+/**
+ * Write the buffered text to the stream and clear the buffer when it has reached the
+ * given size. This is used to write large xml documents (i.e. the dump files) in chunks
+ * instead of building them in memory.
+ * @param out The stream to write to
+ * @param buffer The buffered text
+ * @param size The size of the chunks
+ */
+CPPCHECKLIB void writeChunk(std::ostream &out, std::string &buffer, std::size_t size = 64 * 1024);
+
 namespace utils {
     /**
      * Drop-in replacement for C++17's std::as_const
@@ -81,6 +81,7 @@
 #include "astutils.h"
 #include "calculate.h"
 #include "checkuninitvar.h"
+#include "color.h"
 #include "config.h"
 #include "errorlogger.h"
 #include "errortypes.h"
@@ -89,6 +90,7 @@
 #include "infer.h"
 #include "library.h"
 #include "mathlib.h"
+#include "parallel.h"
 #include "path.h"
 #include "platform.h"
 #include "programmemory.h"
@@ -113,8 +115,10 @@
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
@@ -914,7 +918,7 @@ static void valueFlowSameExpressions(TokenList& tokenlist, const Settings& setti
         ValueFlow::Value value(val);
         value.setKnown();
 
-        if (isSameExpression(false, tok->astOperand1(), tok->astOperand2(), settings, true, true, &value.errorPath)) {
+        if (isSameExpression(false, tok->astOperand1(), tok->astOperand2(), settings, true, true, &value.errorPath.modify())) {
             setTokenValue(tok, std::move(value), settings);
         }
     }
@@ -1989,7 +1993,7 @@ static void valueFlowForwardLifetime(Token * tok, const TokenList &tokenlist, Er
 {
     // Forward lifetimes to constructed variable
     if (Token::Match(tok->previous(), "%var% {|(") && isVariableDecl(tok->previous())) {
-        std::list<ValueFlow::Value> values = tok->values();
+        std::list<ValueFlow::Value> values(tok->values().cbegin(), tok->values().cend());
         values.remove_if(&isNotLifetimeValue);
         valueFlowForward(nextAfterAstRightmostLeaf(tok), ValueFlow::getEndOfExprScope(tok), tok->previous(), std::move(values), tokenlist, errorLogger, settings);
         return;
@@ -2018,7 +2022,7 @@ static void valueFlowForwardLifetime(Token * tok, const TokenList &tokenlist, Er
         const Token* endOfVarScope = ValueFlow::getEndOfExprScope(expr);
 
         // Only forward lifetime values
-        std::list<ValueFlow::Value> values = parent->astOperand2()->values();
+        std::list<ValueFlow::Value> values(parent->astOperand2()->values().cbegin(), parent->astOperand2()->values().cend());
         values.remove_if(&isNotLifetimeValue);
         // Dont forward lifetimes that overlap
         values.remove_if([&](const ValueFlow::Value& value) {
@@ -2053,14 +2057,14 @@ static void valueFlowForwardLifetime(Token * tok, const TokenList &tokenlist, Er
         const Variable *var = tok->variable();
         const Token *endOfVarScope = var->scope()->bodyEnd;
 
-        std::list<ValueFlow::Value> values = tok->values();
+        std::list<ValueFlow::Value> values(tok->values().cbegin(), tok->values().cend());
         Token *nextExpression = nextAfterAstRightmostLeaf(parent);
         // Only forward lifetime values
         values.remove_if(&isNotLifetimeValue);
         valueFlowForward(nextExpression, endOfVarScope, tok, std::move(values), tokenlist, errorLogger, settings);
         // Cast
     } else if (parent->isCast()) {
-        std::list<ValueFlow::Value> values = tok->values();
+        std::list<ValueFlow::Value> values(tok->values().cbegin(), tok->values().cend());
         // Only forward lifetime values
         values.remove_if(&isNotLifetimeValue);
         for (ValueFlow::Value& value:values)
@@ -3592,9 +3596,244 @@ static std::set<nonneg int> getVarIds(const Token* tok)
     return result;
 }
 
-static void valueFlowSymbolic(const TokenList& tokenlist, const SymbolDatabase& symboldatabase, ErrorLogger& errorLogger, const Settings& settings)
+/**
+ * @brief The scopes that are analysed by the scope-local passes.
+ *
+ * With --valueflow-jobs the scopes are grouped by the outermost executable scope they
+ * are nested in and the groups are analysed in parallel. The analysis of a group reads
+ * the values of the functions that are called in it, so the groups that reach each
+ * other through the calls are analysed in the serial order. The values are therefore
+ * the same as with a serial analysis.
+ *
+ * With --valueflow-worklist a pass only analyses the groups where the values of the
+ * group, of the groups it reaches through the calls or of the tokens outside of the
+ * groups changed since the pass analysed the group the last time.
+ */
+struct ValueFlowScopeGroups {
+    struct Group {
+        std::vector<const Scope*> functionScopes;
+        std::vector<const Scope*> forScopes;
+    };
+
+    ValueFlowScopeGroups(const TokenList& tokenlist, const SymbolDatabase& symboldatabase, const Settings& settings);
+
+    /** Start the pass @p name. The groups that it analyses are determined when it calls run(). */
+    void beginPass(const char* name)
+    {
+        pass = name;
+        activeValid = false;
+    }
+
+    /** Call @p f with every group that needs to be analysed. The messages are reported in the order of the groups. */
+    template<class F>
+    void run(ErrorLogger& errorLogger, const F& f)
+    {
+        setActiveGroups();
+        if (jobs <= 1 || active.size() <= 1) {
+            for (const std::size_t i : active)
+                f(groups[i], errorLogger);
+            return;
+        }
+
+        std::vector<BufferedErrorLogger> buffers(active.size());
+        const std::vector<std::exception_ptr> exceptions = executeParallel(active.size(), jobs, activeDependencies, [&](std::size_t i) {
+            f(groups[active[i]], buffers[i]);
+        });
+
+        for (std::size_t i = 0; i < active.size(); ++i) {
+            buffers[i].forward(errorLogger);
+            if (exceptions[i])
+                std::rethrow_exception(exceptions[i]);
+        }
+    }
+
+    const TokenList& tokenlist;
+    std::vector<Group> groups;
+    /** The outermost executable scope of each group */
+    std::vector<const Scope*> roots;
+    /** The lower groups that need to be analysed before each group */
+    std::vector<std::vector<std::size_t>> dependencies;
+    unsigned int jobs;
+
+    bool worklist;
+    /** The groups that are reached by the calls of each group (--valueflow-worklist) */
+    std::vector<std::vector<std::size_t>> reach;
+    /** Incremented every time the values are counted */
+    std::size_t epoch{};
+    std::vector<std::size_t> valueCounts;
+    std::size_t otherValueCount{};
+    /** The epoch when the values of each group were changed */
+    std::vector<std::size_t> changed;
+    std::size_t otherChanged{};
+    /** The epoch when each pass analysed each group */
+    std::map<std::string, std::vector<std::size_t>> lastRun;
+
+    /** The number of groups that have been analysed and skipped by the passes */
+    std::size_t analysedGroups{};
+    std::size_t skippedGroups{};
+
+private:
+    void setActiveGroups();
+    void countValues();
+
+    const char* pass = "";
+    bool activeValid{};
+    std::vector<std::size_t> active;
+    std::vector<std::vector<std::size_t>> activeDependencies;
+};
+
+ValueFlowScopeGroups::ValueFlowScopeGroups(const TokenList& tokenlist, const SymbolDatabase& symboldatabase, const Settings& settings)
+    : tokenlist(tokenlist), jobs(settings.valueFlowJobs), worklist(settings.vfOptions.worklist)
 {
-    for (const Scope* scope : symboldatabase.functionScopes) {
+    if (jobs <= 1 && !worklist) {
+        groups.resize(1);
+        groups[0].functionScopes = symboldatabase.functionScopes;
+        for (const Scope& scope : symboldatabase.scopeList) {
+            if (scope.type == ScopeType::eFor)
+                groups[0].forScopes.push_back(&scope);
+        }
+        dependencies.resize(1);
+        return;
+    }
+
+    std::unordered_map<const Scope*, std::size_t> scopeGroup;
+    for (const Scope& scope : symboldatabase.scopeList) {
+        if (!scope.isExecutable())
+            continue;
+        const Scope* root = &scope;
+        for (const Scope* s = scope.nestedIn; s; s = s->nestedIn) {
+            if (s->isExecutable())
+                root = s;
+        }
+        const auto it = scopeGroup.find(root);
+        const std::size_t index = (it == scopeGroup.end()) ? groups.size() : it->second;
+        if (index == groups.size()) {
+            scopeGroup.emplace(root, index);
+            roots.push_back(root);
+            groups.emplace_back();
+        }
+        scopeGroup.emplace(&scope, index);
+        if (scope.type == ScopeType::eFunction)
+            groups[index].functionScopes.push_back(&scope);
+        else if (scope.type == ScopeType::eFor)
+            groups[index].forScopes.push_back(&scope);
+    }
+
+    std::vector<std::vector<std::size_t>> callees(groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        for (const Token* tok = roots[i]->bodyStart; tok != roots[i]->bodyEnd; tok = tok->next()) {
+            if (!tok->function() || !tok->function()->functionScope)
+                continue;
+            const auto it = scopeGroup.find(tok->function()->functionScope);
+            if (it != scopeGroup.end() && it->second != i)
+                callees[i].push_back(it->second);
+        }
+        std::sort(callees[i].begin(), callees[i].end());
+        callees[i].erase(std::unique(callees[i].begin(), callees[i].end()), callees[i].end());
+    }
+
+    // the groups that reach each other through the calls depend on the lower one
+    dependencies.resize(groups.size());
+    if (worklist)
+        reach.resize(groups.size());
+    std::vector<std::size_t> visited(groups.size(), groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        visited[i] = i;
+        std::vector<std::size_t> stack = callees[i];
+        while (!stack.empty()) {
+            const std::size_t j = stack.back();
+            stack.pop_back();
+            if (visited[j] == i)
+                continue;
+            visited[j] = i;
+            if (worklist)
+                reach[i].push_back(j);
+            if (j < i)
+                dependencies[i].push_back(j);
+            else
+                dependencies[j].push_back(i);
+            stack.insert(stack.end(), callees[j].cbegin(), callees[j].cend());
+        }
+    }
+    for (std::vector<std::size_t>& d : dependencies) {
+        std::sort(d.begin(), d.end());
+        d.erase(std::unique(d.begin(), d.end()), d.end());
+    }
+
+    valueCounts.resize(groups.size());
+    changed.resize(groups.size());
+}
+
+void ValueFlowScopeGroups::countValues()
+{
+    ++epoch;
+    std::size_t total = 0;
+    for (const Token* tok = tokenlist.front(); tok; tok = tok->next())
+        total += tok->values().size();
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        // the values of the parameters are part of the function
+        const Token* start = roots[i]->classDef ? roots[i]->classDef : roots[i]->bodyStart;
+        std::size_t n = 0;
+        for (const Token* tok = start; tok && tok != roots[i]->bodyEnd; tok = tok->next())
+            n += tok->values().size();
+        total -= n;
+        if (n != valueCounts[i]) {
+            valueCounts[i] = n;
+            changed[i] = epoch;
+        }
+    }
+    if (total != otherValueCount) {
+        otherValueCount = total;
+        otherChanged = epoch;
+    }
+}
+
+void ValueFlowScopeGroups::setActiveGroups()
+{
+    if (activeValid)
+        return;
+    activeValid = true;
+    active.clear();
+
+    if (!worklist) {
+        for (std::size_t i = 0; i < groups.size(); ++i)
+            active.push_back(i);
+        analysedGroups += groups.size();
+        activeDependencies = dependencies;
+        return;
+    }
+
+    countValues();
+    std::vector<std::size_t>& last = lastRun[pass];
+    last.resize(groups.size());
+    std::vector<std::size_t> position(groups.size(), groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        // the changes that are seen in the epoch of the last run have been analysed
+        const bool needed = last[i] == 0 || otherChanged > last[i] || changed[i] > last[i] ||
+                            std::any_of(reach[i].cbegin(), reach[i].cend(), [&](std::size_t j) {
+            return changed[j] > last[i];
+        });
+        if (!needed)
+            continue;
+        last[i] = epoch;
+        position[i] = active.size();
+        active.push_back(i);
+    }
+    analysedGroups += active.size();
+    skippedGroups += groups.size() - active.size();
+
+    activeDependencies.assign(active.size(), {});
+    for (std::size_t i = 0; i < active.size(); ++i) {
+        for (const std::size_t d : dependencies[active[i]]) {
+            if (position[d] < active.size())
+                activeDependencies[i].push_back(position[d]);
+        }
+    }
+}
+
+static void valueFlowSymbolic(const TokenList& tokenlist, const std::vector<const Scope*>& functionScopes, ErrorLogger& errorLogger, const Settings& settings)
+{
+    for (const Scope* scope : functionScopes) {
         for (auto* tok = const_cast<Token*>(scope->bodyStart); tok != scope->bodyEnd; tok = tok->next()) {
             if (!Token::simpleMatch(tok, "="))
                 continue;
@@ -3658,6 +3897,13 @@ static void valueFlowSymbolic(const TokenList& tokenlist, const SymbolDatabase&
     }
 }
 
+static void valueFlowSymbolic(const TokenList& tokenlist, ValueFlowScopeGroups& scopeGroups, ErrorLogger& errorLogger, const Settings& settings)
+{
+    scopeGroups.run(errorLogger, [&](const ValueFlowScopeGroups::Group& group, ErrorLogger& groupErrorLogger) {
+        valueFlowSymbolic(tokenlist, group.functionScopes, groupErrorLogger, settings);
+    });
+}
+
 static const Token* isStrlenOf(const Token* tok, const Token* expr, int depth = 10)
 {
     if (depth < 0)
@@ -3889,13 +4135,12 @@ static void valueFlowForwardConst(Token* start,
                     return;
                 }
                 // Follow symbolic values
-                for (const ValueFlow::Value& v : tok->values()) {
-                    if (!v.isSymbolicValue())
-                        continue;
-                    if (!v.tokvalue)
-                        continue;
-                    if (v.tokvalue->varId() != var->declarationId())
-                        continue;
+                // the values of tok are copied since setTokenValue() modifies them
+                std::vector<ValueFlow::Value> symValues;
+                std::copy_if(tok->values().cbegin(), tok->values().cend(), std::back_inserter(symValues), [&](const ValueFlow::Value& v) {
+                    return v.isSymbolicValue() && v.tokvalue && v.tokvalue->varId() == var->declarationId();
+                });
+                for (const ValueFlow::Value& v : symValues) {
                     for (ValueFlow::Value value : values) {
                         if (!v.isKnown() && value.isImpossible())
                             continue;
@@ -4171,12 +4416,12 @@ static bool intersects(const C1& c1, const C2& c2)
 }
 
 static void valueFlowAfterAssign(const TokenList &tokenlist,
-                                 const SymbolDatabase& symboldatabase,
+                                 const std::vector<const Scope*>& functionScopes,
                                  ErrorLogger &errorLogger,
                                  const Settings &settings,
                                  const std::set<const Scope*>& skippedFunctions)
 {
-    for (const Scope * scope : symboldatabase.functionScopes) {
+    for (const Scope * scope : functionScopes) {
         if (skippedFunctions.count(scope))
             continue;
         std::unordered_map<nonneg int, std::unordered_set<nonneg int>> backAssigns;
@@ -4207,7 +4452,7 @@ static void valueFlowAfterAssign(const TokenList &tokenlist,
                 continue;
 
             std::list<ValueFlow::Value> values = truncateValues(
-                rhs->values(), tok->astOperand1()->valueType(), rhs->valueType(), settings);
+                std::list<ValueFlow::Value>(rhs->values().cbegin(), rhs->values().cend()), tok->astOperand1()->valueType(), rhs->valueType(), settings);
             // Remove known values
             std::set<ValueFlow::Value::ValueType> types;
             if (tok->astOperand1()->hasKnownValue()) {
@@ -4306,6 +4551,17 @@ static void valueFlowAfterAssign(const TokenList &tokenlist,
     }
 }
 
+static void valueFlowAfterAssign(const TokenList &tokenlist,
+                                 ValueFlowScopeGroups& scopeGroups,
+                                 ErrorLogger &errorLogger,
+                                 const Settings &settings,
+                                 const std::set<const Scope*>& skippedFunctions)
+{
+    scopeGroups.run(errorLogger, [&](const ValueFlowScopeGroups::Group& group, ErrorLogger& groupErrorLogger) {
+        valueFlowAfterAssign(tokenlist, group.functionScopes, groupErrorLogger, settings, skippedFunctions);
+    });
+}
+
 static std::vector<const Variable*> getVariables(const Token* tok)
 {
     std::vector<const Variable*> result;
@@ -4337,8 +4593,8 @@ static void valueFlowAfterSwap(const TokenList& tokenlist,
                 continue;
             for (int i = 0; i < 2; i++) {
                 std::vector<const Variable*> vars = getVariables(args[0]);
-                const std::list<ValueFlow::Value>& values = args[0]->values();
-                valueFlowForwardAssign(args[0], args[1], std::move(vars), values, false, tokenlist, errorLogger, settings);
+                std::list<ValueFlow::Value> values(args[0]->values().cbegin(), args[0]->values().cend());
+                valueFlowForwardAssign(args[0], args[1], std::move(vars), std::move(values), false, tokenlist, errorLogger, settings);
                 std::swap(args[0], args[1]);
             }
         }
@@ -4492,12 +4748,12 @@ struct ConditionHandler {
         valueFlowReverse(start, endToken, exprTok, values, tokenlist, errorLogger, settings, loc);
     }
 
-    void traverseCondition(const SymbolDatabase& symboldatabase,
+    void traverseCondition(const std::vector<const Scope*>& functionScopes,
                            const Settings& settings,
                            const std::set<const Scope*>& skippedFunctions,
                            const std::function<void(const Condition& cond, Token* tok, const Scope* scope)>& f) const
     {
-        for (const Scope *scope : symboldatabase.functionScopes) {
+        for (const Scope *scope : functionScopes) {
             if (skippedFunctions.count(scope))
                 continue;
             for (auto *tok = const_cast<Token *>(scope->bodyStart); tok != scope->bodyEnd; tok = tok->next()) {
@@ -4528,11 +4784,11 @@ struct ConditionHandler {
     }
 
     void beforeCondition(TokenList& tokenlist,
-                         const SymbolDatabase& symboldatabase,
+                         const std::vector<const Scope*>& functionScopes,
                          ErrorLogger& errorLogger,
                          const Settings& settings,
                          const std::set<const Scope*>& skippedFunctions) const {
-        traverseCondition(symboldatabase, settings, skippedFunctions, [&](const Condition& cond, Token* tok, const Scope*) {
+        traverseCondition(functionScopes, settings, skippedFunctions, [&](const Condition& cond, Token* tok, const Scope*) {
             if (cond.vartok->exprId() == 0)
                 return;
 
@@ -4688,11 +4944,11 @@ struct ConditionHandler {
     }
 
     void afterCondition(TokenList& tokenlist,
-                        const SymbolDatabase& symboldatabase,
+                        const std::vector<const Scope*>& functionScopes,
                         ErrorLogger& errorLogger,
                         const Settings& settings,
                         const std::set<const Scope*>& skippedFunctions) const {
-        traverseCondition(symboldatabase, settings, skippedFunctions, [&](const Condition& cond, Token* condTok, const Scope* scope) {
+        traverseCondition(functionScopes, settings, skippedFunctions, [&](const Condition& cond, Token* condTok, const Scope* scope) {
             const MathLib::bigint path = cond.getPath();
             const bool allowKnown = path == 0;
 
@@ -5024,13 +5280,17 @@ protected:
 
 static void valueFlowCondition(const ValuePtr<ConditionHandler>& handler,
                                TokenList& tokenlist,
-                               SymbolDatabase& symboldatabase,
+                               ValueFlowScopeGroups& scopeGroups,
                                ErrorLogger& errorLogger,
                                const Settings& settings,
                                const std::set<const Scope*>& skippedFunctions)
 {
-    handler->beforeCondition(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions);
-    handler->afterCondition(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions);
+    scopeGroups.run(errorLogger, [&](const ValueFlowScopeGroups::Group& group, ErrorLogger& groupErrorLogger) {
+        handler->beforeCondition(tokenlist, group.functionScopes, groupErrorLogger, settings, skippedFunctions);
+    });
+    scopeGroups.run(errorLogger, [&](const ValueFlowScopeGroups::Group& group, ErrorLogger& groupErrorLogger) {
+        handler->afterCondition(tokenlist, group.functionScopes, groupErrorLogger, settings, skippedFunctions);
+    });
 }
 
 static const Token* getConditionVariable(const Token* tok)
@@ -5429,14 +5689,11 @@ static void valueFlowForLoopSimplifyAfter(Token* fortok, nonneg int varid, const
     }
 }
 
-static void valueFlowForLoop(const TokenList &tokenlist, const SymbolDatabase& symboldatabase, ErrorLogger &errorLogger, const Settings &settings)
+static void valueFlowForLoop(const TokenList &tokenlist, const std::vector<const Scope*>& forScopes, ErrorLogger &errorLogger, const Settings &settings)
 {
-    for (const Scope &scope : symboldatabase.scopeList) {
-        if (scope.type != ScopeType::eFor)
-            continue;
-
-        auto* tok = const_cast<Token*>(scope.classDef);
-        auto* const bodyStart = const_cast<Token*>(scope.bodyStart);
+    for (const Scope *scope : forScopes) {
+        auto* tok = const_cast<Token*>(scope->classDef);
+        auto* const bodyStart = const_cast<Token*>(scope->bodyStart);
 
         if (!Token::simpleMatch(tok->next()->astOperand2(), ";") ||
             !Token::simpleMatch(tok->next()->astOperand2()->astOperand2(), ";"))
@@ -5511,6 +5768,13 @@ static void valueFlowForLoop(const TokenList &tokenlist, const SymbolDatabase& s
     }
 }
 
+static void valueFlowForLoop(const TokenList &tokenlist, ValueFlowScopeGroups& scopeGroups, ErrorLogger &errorLogger, const Settings &settings)
+{
+    scopeGroups.run(errorLogger, [&](const ValueFlowScopeGroups::Group& group, ErrorLogger& groupErrorLogger) {
+        valueFlowForLoop(tokenlist, group.forScopes, groupErrorLogger, settings);
+    });
+}
+
 template<class Key, class F>
 static bool productParams(const Settings& settings, const std::unordered_map<Key, std::list<ValueFlow::Value>>& vars, F f)
 {
@@ -5697,7 +5961,7 @@ static void valueFlowSwitchVariable(const TokenList& tokenlist,
 
 static std::list<ValueFlow::Value> getFunctionArgumentValues(const Token* argtok)
 {
-    std::list<ValueFlow::Value> argvalues(argtok->values());
+    std::list<ValueFlow::Value> argvalues(argtok->values().cbegin(), argtok->values().cend());
     removeImpossible(argvalues);
     if (argvalues.empty() && Token::Match(argtok, "%comp%|%oror%|&&|!")) {
         argvalues.emplace_back(0);
@@ -5830,7 +6094,7 @@ static void valueFlowFunctionDefaultParameter(const TokenList& tokenlist, const
         for (size_t arg = function->minArgCount(); arg < function->argCount(); arg++) {
             const Variable* var = function->getArgumentVar(arg);
             if (var && var->hasDefault() && Token::Match(var->nameToken(), "%var% = %num%|%str%|%char%|%name% [,)]")) {
-                const std::list<ValueFlow::Value> &values = var->nameToken()->tokAt(2)->values();
+                const std::vector<ValueFlow::Value> &values = var->nameToken()->tokAt(2)->values();
                 std::list<ValueFlow::Value> argvalues;
                 for (const ValueFlow::Value &value : values) {
                     if (!value.isKnown())
@@ -6374,7 +6638,7 @@ static void valueFlowSmartPointer(TokenList &tokenlist, ErrorLogger & errorLogge
                 if (Token::Match(tok, "%var% (|{") && tok->next()->astOperand2() &&
                     tok->next()->astOperand2()->str() != ",") {
                     Token* inTok = tok->next()->astOperand2();
-                    const std::list<ValueFlow::Value>& values = inTok->values();
+                    std::list<ValueFlow::Value> values(inTok->values().cbegin(), inTok->values().cend());
                     const bool constValue = inTok->isNumber();
                     valueFlowForwardAssign(inTok, var, values, constValue, true, tokenlist, errorLogger, settings);
 
@@ -6398,8 +6662,8 @@ static void valueFlowSmartPointer(TokenList &tokenlist, ErrorLogger & errorLogge
                     Token* inTok = ftok->astOperand2();
                     if (!inTok)
                         continue;
-                    const std::list<ValueFlow::Value>& values = inTok->values();
-                    valueFlowForwardAssign(inTok, tok, std::move(vars), values, false, tokenlist, errorLogger, settings);
+                    std::list<ValueFlow::Value> values(inTok->values().cbegin(), inTok->values().cend());
+                    valueFlowForwardAssign(inTok, tok, std::move(vars), std::move(values), false, tokenlist, errorLogger, settings);
                 }
             } else if (Token::simpleMatch(tok->astParent(), ". release ( )")) {
                 const Token* parent = ftok->astParent();
@@ -6477,15 +6741,16 @@ static void valueFlowIterators(TokenList& tokenlist, const Settings& settings)
     }
 }
 
-static std::list<ValueFlow::Value> getIteratorValues(std::list<ValueFlow::Value> values,
+static std::list<ValueFlow::Value> getIteratorValues(const std::vector<ValueFlow::Value>& values,
                                                      const ValueFlow::Value::ValueKind* kind = nullptr)
 {
-    values.remove_if([&](const ValueFlow::Value& v) {
+    std::list<ValueFlow::Value> result;
+    std::copy_if(values.cbegin(), values.cend(), std::back_inserter(result), [&](const ValueFlow::Value& v) {
         if (kind && v.valueKind != *kind)
-            return true;
-        return !v.isIteratorValue();
+            return false;
+        return v.isIteratorValue();
     });
-    return values;
+    return result;
 }
 
 struct IteratorConditionHandler : SimpleConditionHandler {
@@ -7288,8 +7553,9 @@ struct ValueFlowState {
     explicit ValueFlowState(TokenList& tokenlist,
                             SymbolDatabase& symboldatabase,
                             ErrorLogger& errorLogger,
-                            const Settings& settings)
-        : tokenlist(tokenlist), symboldatabase(symboldatabase), errorLogger(errorLogger), settings(settings)
+                            const Settings& settings,
+                            ValueFlowScopeGroups& scopeGroups)
+        : tokenlist(tokenlist), symboldatabase(symboldatabase), errorLogger(errorLogger), settings(settings), scopeGroups(scopeGroups)
     {}
 
     TokenList& tokenlist;
@@ -7297,6 +7563,7 @@ struct ValueFlowState {
     ErrorLogger& errorLogger;
     const Settings& settings;
     std::set<const Scope*> skippedFunctions;
+    ValueFlowScopeGroups& scopeGroups;
 };
 
 struct ValueFlowPass {
@@ -7321,14 +7588,14 @@ struct ValueFlowPassRunner {
         setStopTime();
     }
 
-    bool run_once(std::initializer_list<ValuePtr<ValueFlowPass>> passes) const
+    bool run_once(std::initializer_list<ValuePtr<ValueFlowPass>> passes)
     {
         return std::any_of(passes.begin(), passes.end(), [&](const ValuePtr<ValueFlowPass>& pass) {
             return run(pass, 0);
         });
     }
 
-    bool run(std::initializer_list<ValuePtr<ValueFlowPass>> passes) const
+    bool run(std::initializer_list<ValuePtr<ValueFlowPass>> passes)
     {
         std::size_t values = 0;
         std::size_t n = state.settings.vfOptions.maxIterations;
@@ -7337,12 +7604,25 @@ struct ValueFlowPassRunner {
             values = getTotalValues();
             const std::size_t passnum = state.settings.vfOptions.maxIterations - n + 1;
             const std::string passnum_s = std::to_string(passnum);
-            if (std::any_of(passes.begin(), passes.end(), [&](const ValuePtr<ValueFlowPass>& pass) {
+            std::vector<std::size_t> valueCounts;
+            if (state.settings.valueFlowStats)
+                valueCounts = getValueCounts();
+            const std::size_t analysedGroups = state.scopeGroups.analysedGroups;
+            const std::size_t skippedGroups = state.scopeGroups.skippedGroups;
+            const bool stopped = std::any_of(passes.begin(), passes.end(), [&](const ValuePtr<ValueFlowPass>& pass) {
                 // the string concatination is a hot spot in TestIO::testScanfArgument and TestIO::testPrintfArgumentVariables
                 std::string stage = doProgress ? std::string("ValueFlow::") + pass->name() + (' ' + passnum_s) : "";
                 ProgressReporter progressReporter(state.errorLogger, state.settings.reportProgress, state.tokenlist.getSourceFilePath(), std::move(stage));
                 return run(pass, passnum);
-            }))
+            });
+            if (state.settings.valueFlowStats) {
+                IterationStatistics stats;
+                stats.changedTokens = getChangedTokens(valueCounts);
+                stats.analysedGroups = state.scopeGroups.analysedGroups - analysedGroups;
+                stats.skippedGroups = state.scopeGroups.skippedGroups - skippedGroups;
+                iterationStatistics.push_back(stats);
+            }
+            if (stopped)
                 return true;
             --n;
         }
@@ -7361,7 +7641,7 @@ struct ValueFlowPassRunner {
         return false;
     }
 
-    bool run(const ValuePtr<ValueFlowPass>& pass, std::size_t it) const
+    bool run(const ValuePtr<ValueFlowPass>& pass, std::size_t it)
     {
         auto start = Clock::now();
         if (start > stop) {
@@ -7370,6 +7650,10 @@ struct ValueFlowPassRunner {
         }
         if (!state.tokenlist.isCPP() && pass->cpp())
             return false;
+        std::vector<std::size_t> valueCounts;
+        if (state.settings.valueFlowStats)
+            valueCounts = getValueCounts();
+        state.scopeGroups.beginPass(pass->name());
         if (timerResults) {
             std::string name = pass->name();
             if (it > 0) {
@@ -7381,9 +7665,60 @@ struct ValueFlowPassRunner {
         } else {
             pass->run(state);
         }
+        if (state.settings.valueFlowStats) {
+            auto stats = std::find_if(passStatistics.begin(), passStatistics.end(), [&](const PassStatistics& p) {
+                return p.name == pass->name();
+            });
+            if (stats == passStatistics.end()) {
+                passStatistics.emplace_back();
+                stats = passStatistics.end() - 1;
+                stats->name = pass->name();
+            }
+            ++stats->iterations;
+            stats->changedTokens += getChangedTokens(valueCounts);
+        }
         return false;
     }
 
+    std::vector<std::size_t> getValueCounts() const
+    {
+        std::vector<std::size_t> valueCounts;
+        for (const Token* tok = state.tokenlist.front(); tok; tok = tok->next())
+            valueCounts.push_back(tok->values().size());
+        return valueCounts;
+    }
+
+    /** The number of tokens where the number of values is different from @p valueCounts */
+    std::size_t getChangedTokens(const std::vector<std::size_t>& valueCounts) const
+    {
+        std::size_t n = 0;
+        std::size_t i = 0;
+        for (const Token* tok = state.tokenlist.front(); tok; tok = tok->next(), ++i) {
+            if (tok->values().size() != valueCounts[i])
+                ++n;
+        }
+        return n;
+    }
+
+    /** Report the statistics (--valueflow-stats) */
+    void reportStatistics() const
+    {
+        const std::string prefix = "ValueFlow: " + state.tokenlist.getSourceFilePath() + ": ";
+        for (std::size_t i = 0; i < iterationStatistics.size(); ++i) {
+            const IterationStatistics& stats = iterationStatistics[i];
+            state.errorLogger.reportOut(prefix + "iteration " + std::to_string(i + 1) + ": " +
+                                        std::to_string(stats.changedTokens) + " changed tokens, " +
+                                        std::to_string(stats.analysedGroups) + " analysed and " +
+                                        std::to_string(stats.skippedGroups) + " skipped scope groups",
+                                        Color::Reset);
+        }
+        for (const PassStatistics& p : passStatistics) {
+            state.errorLogger.reportOut(prefix + p.name + ": " + std::to_string(p.iterations) + " iterations, " +
+                                        std::to_string(p.changedTokens) + " changed tokens",
+                                        Color::Reset);
+        }
+    }
+
     std::size_t getTotalValues() const
     {
         std::size_t n = 1;
@@ -7435,9 +7770,24 @@ struct ValueFlowPassRunner {
             stop = Clock::now() + std::chrono::seconds{state.settings.vfOptions.maxTime};
     }
 
+    struct PassStatistics {
+        std::string name;
+        std::size_t iterations{};
+        std::size_t changedTokens{};
+    };
+
+    struct IterationStatistics {
+        std::size_t changedTokens{};
+        std::size_t analysedGroups{};
+        std::size_t skippedGroups{};
+    };
+
     ValueFlowState state;
     TimePoint stop;
     TimerResultsIntf* timerResults;
+    /** The statistics of the passes in the order of their first execution (--valueflow-stats) */
+    std::vector<PassStatistics> passStatistics;
+    std::vector<IterationStatistics> iterationStatistics;
 };
 
 template<class F>
@@ -7451,7 +7801,7 @@ struct ValueFlowPassAdaptor : ValueFlowPass {
     }
     void run(const ValueFlowState& state) const override
     {
-        mRun(state.tokenlist, state.symboldatabase, state.errorLogger, state.settings, state.skippedFunctions);
+        mRun(state.tokenlist, state.symboldatabase, state.errorLogger, state.settings, state.skippedFunctions, state.scopeGroups);
     }
     bool cpp() const override {
         return mCPP;
@@ -7471,12 +7821,14 @@ static ValueFlowPassAdaptor<F> makeValueFlowPassAdaptor(const char* name, bool c
                                 SymbolDatabase& symboldatabase,                                                        \
                                 ErrorLogger& errorLogger,                                                              \
                                 const Settings& settings,                                                              \
-                                const std::set<const Scope*>& skippedFunctions) {                                      \
+                                const std::set<const Scope*>& skippedFunctions,                                        \
+                                ValueFlowScopeGroups& scopeGroups) {                                             \
         (void)tokenlist;                                                                      \
         (void)symboldatabase;                                                                 \
         (void)errorLogger;                                                                    \
         (void)settings;                                                                       \
         (void)skippedFunctions;                                                               \
+        (void)scopeGroups;                                                                    \
         __VA_ARGS__;                                                                          \
     })
 
@@ -7506,7 +7858,8 @@ void ValueFlow::setValues(TokenList& tokenlist,
         }
     }
 
-    ValueFlowPassRunner runner{ValueFlowState{tokenlist, symboldatabase, errorLogger, settings}, timerResults};
+    ValueFlowScopeGroups scopeGroups(tokenlist, symboldatabase, settings);
+    ValueFlowPassRunner runner{ValueFlowState{tokenlist, symboldatabase, errorLogger, settings, scopeGroups}, timerResults};
     runner.run_once({
         VFA(valueFlowEnumValueEarly(symboldatabase, settings)),
         VFA(valueFlowNumber(tokenlist, settings)),
@@ -7519,7 +7872,7 @@ void ValueFlow::setValues(TokenList& tokenlist,
         VFA(valueFlowGlobalStaticVar(tokenlist, settings)),
         VFA(valueFlowPointerAlias(tokenlist, settings)),
         VFA(valueFlowLifetime(tokenlist, errorLogger, settings)),
-        VFA(valueFlowSymbolic(tokenlist, symboldatabase, errorLogger, settings)),
+        VFA(valueFlowSymbolic(tokenlist, scopeGroups, errorLogger, settings)),
         VFA(valueFlowBitAnd(tokenlist, settings)),
         VFA(valueFlowSameExpressions(tokenlist, settings)),
         VFA(valueFlowConditionExpressions(tokenlist, symboldatabase, errorLogger, settings)),
@@ -7528,19 +7881,19 @@ void ValueFlow::setValues(TokenList& tokenlist,
     runner.run({
         VFA(valueFlowImpossibleValues(tokenlist, settings)),
         VFA(valueFlowSymbolicOperators(symboldatabase, settings)),
-        VFA(valueFlowCondition(SymbolicConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+        VFA(valueFlowCondition(SymbolicConditionHandler{}, tokenlist, scopeGroups, errorLogger, settings, skippedFunctions)),
         VFA(valueFlowSymbolicInfer(symboldatabase, settings)),
         VFA(valueFlowArrayBool(tokenlist, settings)),
         VFA(valueFlowArrayElement(tokenlist, settings)),
         VFA(valueFlowRightShift(tokenlist, settings)),
         VFA_CPP(
-            valueFlowCondition(ContainerConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
-        VFA(valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+            valueFlowCondition(ContainerConditionHandler{}, tokenlist, scopeGroups, errorLogger, settings, skippedFunctions)),
+        VFA(valueFlowAfterAssign(tokenlist, scopeGroups, errorLogger, settings, skippedFunctions)),
         VFA_CPP(valueFlowAfterSwap(tokenlist, symboldatabase, errorLogger, settings)),
-        VFA(valueFlowCondition(SimpleConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+        VFA(valueFlowCondition(SimpleConditionHandler{}, tokenlist, scopeGroups, errorLogger, settings, skippedFunctions)),
         VFA(valueFlowInferCondition(tokenlist, settings)),
         VFA(valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings)),
-        VFA(valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings)),
+        VFA(valueFlowForLoop(tokenlist, scopeGroups, errorLogger, settings)),
         VFA(valueFlowSubFunction(tokenlist, symboldatabase, errorLogger, settings)),
         VFA(valueFlowFunctionReturn(tokenlist, errorLogger, settings)),
         VFA(valueFlowLifetime(tokenlist, errorLogger, settings)),
@@ -7550,7 +7903,7 @@ void ValueFlow::setValues(TokenList& tokenlist,
         VFA_CPP(valueFlowSmartPointer(tokenlist, errorLogger, settings)),
         VFA_CPP(valueFlowIterators(tokenlist, settings)),
         VFA_CPP(
-            valueFlowCondition(IteratorConditionHandler{}, tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
+            valueFlowCondition(IteratorConditionHandler{}, tokenlist, scopeGroups, errorLogger, settings, skippedFunctions)),
         VFA_CPP(valueFlowIteratorInfer(tokenlist, settings)),
         VFA_CPP(valueFlowContainerSize(tokenlist, symboldatabase, errorLogger, settings, skippedFunctions)),
         VFA(valueFlowSafeFunctions(tokenlist, symboldatabase, errorLogger, settings)),
@@ -7560,6 +7913,9 @@ void ValueFlow::setValues(TokenList& tokenlist,
         VFA(valueFlowDynamicBufferSize(tokenlist, symboldatabase, errorLogger, settings)),
         VFA(valueFlowDebug(tokenlist, errorLogger, settings)), // TODO: add option to print it after each step/iteration
     });
+
+    if (settings.valueFlowStats)
+        runner.reportStatistics();
 }
 
 std::string ValueFlow::eitherTheConditionIsRedundant(const Token *condition)
@@ -7578,7 +7934,7 @@ std::string ValueFlow::eitherTheConditionIsRedundant(const Token *condition)
     return "Either the condition '" + condition->expressionString() + "' is redundant";
 }
 
-const ValueFlow::Value* ValueFlow::findValue(const std::list<ValueFlow::Value>& values,
+const ValueFlow::Value* ValueFlow::findValue(const std::vector<ValueFlow::Value>& values,
                                              const Settings& settings,
                                              const std::function<bool(const ValueFlow::Value&)> &pred)
 {
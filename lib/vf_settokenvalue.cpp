@@ -38,7 +38,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <list>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -421,7 +420,7 @@ namespace ValueFlow
                     const Token *op = cond ? tok->astOperand1() : tok->astOperand2();
                     if (!op) // #7769 segmentation fault at setTokenValue()
                         return;
-                    const std::list<Value> &values = op->values();
+                    const std::vector<Value> &values = op->values();
                     if (std::find(values.cbegin(), values.cend(), value) != values.cend())
                         setTokenValue(parent, std::move(value), settings);
                 }
@@ -451,7 +450,7 @@ namespace ValueFlow
 
         else if (parent->str() == "?" && value.isIntValue() && tok == parent->astOperand1() && value.isKnown() &&
                  parent->astOperand2() && parent->astOperand2()->astOperand1() && parent->astOperand2()->astOperand2()) {
-            const std::list<Value> &values = (value.intvalue == 0
+            const std::vector<Value> &values = (value.intvalue == 0
                 ? parent->astOperand2()->astOperand2()->values()
                 : parent->astOperand2()->astOperand1()->values());
 
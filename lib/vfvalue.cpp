@@ -22,10 +22,22 @@
 #include "token.h"
 #include "utils.h"
 
+#include <memory>
 #include <sstream>
 #include <string>
 
 namespace ValueFlow {
+    const ErrorPath SharedErrorPath::mEmptyPath;
+
+    ErrorPath& SharedErrorPath::modify()
+    {
+        if (!mPath)
+            mPath = std::make_shared<ErrorPath>();
+        else if (mPath.use_count() > 1)
+            mPath = std::make_shared<ErrorPath>(*mPath);
+        return *mPath;
+    }
+
     Value::Value(const Token *c, MathLib::bigint val, Bound b)
         : bound(b),
         safe(false),
@@ -29,6 +29,8 @@
 #include <cmath>
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -40,6 +42,107 @@ class Token;
 
 namespace ValueFlow
 {
+    /**
+     * @brief ErrorPath which is shared between the copies of a value until one of them is modified.
+     * The values are copied a lot and most copies keep the path of the original.
+     */
+    class CPPCHECKLIB SharedErrorPath {
+    public:
+        using iterator = ErrorPath::iterator;
+        using const_iterator = ErrorPath::const_iterator;
+        using value_type = ErrorPathItem;
+
+        SharedErrorPath() = default;
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        SharedErrorPath(ErrorPath errorPath) {
+            if (!errorPath.empty())
+                mPath = std::make_shared<ErrorPath>(std::move(errorPath));
+        }
+
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        operator const ErrorPath&() const {
+            return get();
+        }
+
+        const ErrorPath& get() const {
+            return mPath ? *mPath : mEmptyPath;
+        }
+
+        /** @return the path for modification, it is copied first if it is shared */
+        ErrorPath& modify();
+
+        bool empty() const {
+            return !mPath || mPath->empty();
+        }
+        std::size_t size() const {
+            return mPath ? mPath->size() : 0;
+        }
+
+        const_iterator begin() const {
+            return get().cbegin();
+        }
+        const_iterator end() const {
+            return get().cend();
+        }
+        const_iterator cbegin() const {
+            return get().cbegin();
+        }
+        const_iterator cend() const {
+            return get().cend();
+        }
+        iterator begin() {
+            return modify().begin();
+        }
+        iterator end() {
+            return modify().end();
+        }
+
+        const ErrorPathItem& front() const {
+            return get().front();
+        }
+        const ErrorPathItem& back() const {
+            return get().back();
+        }
+
+        template<class ... Ts>
+        void emplace_back(Ts&& ... ts) {
+            modify().emplace_back(std::forward<Ts>(ts)...);
+        }
+        template<class ... Ts>
+        void emplace_front(Ts&& ... ts) {
+            modify().emplace_front(std::forward<Ts>(ts)...);
+        }
+        void push_back(ErrorPathItem item) {
+            modify().push_back(std::move(item));
+        }
+        void push_front(ErrorPathItem item) {
+            modify().push_front(std::move(item));
+        }
+
+        /** Insert the items [first, last) before pos. pos may point into the shared path. */
+        template<class Iterator>
+        void insert(const_iterator pos, Iterator first, Iterator last) {
+            const ErrorPath& shared = get();
+            ErrorPath items(first, last);
+            const auto index = std::distance(shared.cbegin(), pos);
+            ErrorPath& path = modify();
+            path.splice(std::next(path.cbegin(), index), items);
+        }
+        void insert(const_iterator pos, ErrorPathItem item) {
+            const auto index = std::distance(get().cbegin(), pos);
+            ErrorPath& path = modify();
+            path.insert(std::next(path.cbegin(), index), std::move(item));
+        }
+
+        void clear() {
+            mPath.reset();
+        }
+
+    private:
+        std::shared_ptr<ErrorPath> mPath;
+        static const ErrorPath mEmptyPath;
+    };
+
     class CPPCHECKLIB Value {
     public:
         enum class Bound : std::uint8_t { Upper, Lower, Point };
@@ -335,9 +438,9 @@ namespace ValueFlow
         /** Condition that this value depends on */
         const Token* condition{};
 
-        ErrorPath errorPath;
+        SharedErrorPath errorPath;
 
-        ErrorPath debugPath; // TODO: make lighter by default
+        SharedErrorPath debugPath; // TODO: make lighter by default
 
         /** For calculated values - varId that calculated value depends on */
         nonneg int varId{};
@@ -6,6 +6,7 @@ objects directly from dicts (which provide the same .get() API
 as the XML elements).
 """
 import json
+import os
 import sys
 
 import pytest
@@ -805,6 +806,74 @@ class TestSuppressions:
         # NOTE: a non-matching line is not checked here - see test_line_suppression_other_line
 
 
+def summarize_dump(data):
+    """Data of the dump that does not depend on the ids (addresses) of the objects and the directory."""
+    def name(path):
+        return os.path.basename(path) if path else path
+
+    def token(tok):
+        return (tok.str, name(tok.file), tok.linenr, tok.column, tok.varId, tok.exprId,
+                tok.astParent.str if tok.astParent else None,
+                tok.link.str if tok.link else None,
+                tok.valueType.type if tok.valueType else None,
+                [(v.valueKind, v.intvalue, v.tokvalue.str if v.tokvalue else None, v.condition)
+                 for v in (tok.values or [])])
+
+    configurations = []
+    for cfg in data.iterconfigurations():
+        configurations.append((cfg.name,
+                               [(d.str, name(d.file), d.linenr) for d in cfg.directives],
+                               [token(tok) for tok in cfg.tokenlist],
+                               [(s.type, s.className, s.bodyStart.linenr if s.bodyStart else None) for s in cfg.scopes],
+                               [(f.name, f.type, len(f.argument)) for f in cfg.functions],
+                               # the variables are ordered by their address
+                               sorted((v.nameToken.str if v.nameToken else '', v.access, v.isArgument) for v in cfg.variables)))
+    return (data.language,
+            data.platform.name,
+            [name(f) for f in data.files],
+            [(tok.str, name(tok.file), tok.linenr, tok.column) for tok in data.rawTokens],
+            [(s.errorId, name(s.fileName), s.lineNumber) for s in data.suppressions],
+            configurations)
+
+
+class TestBinaryDump:
+    """The data of a binary dump must be the same as the data of the xml dump."""
+
+    CODE = ('#define GREETING "<a & \'b\'>"\n'
+            '// cppcheck-suppress unusedVariable\n'
+            'int x;\n'
+            '#ifdef FOO\n'
+            'int foo(void) { return 1; }\n'
+            '#endif\n'
+            'const char *s = GREETING;\n'
+            'int f(int a)\n'
+            '{\n'
+            '    int b = a < 10 ? a << 2 : 0;\n'
+            '    return b & 0xff;\n'
+            '}\n')
+
+    def test_same_data(self, dump_factory):
+        xml = dump_factory.create(self.CODE, extra_args=['--inline-suppr'])
+        binary = dump_factory.create(self.CODE, extra_args=['--inline-suppr', '--dump-format=binary'])
+        with open(xml, 'rb') as f:
+            assert f.read(5) == b'<?xml'
+        with open(binary, 'rb') as f:
+            assert f.read(8) == b'CPPCHKDU'
+        xml_data = summarize_dump(cppcheckdata.parsedump(xml))
+        binary_data = summarize_dump(cppcheckdata.parsedump(binary))
+        assert len(xml_data[5]) == 2
+        assert binary_data == xml_data
+
+    def test_sections(self, dump_factory):
+        binary = dump_factory.create(self.CODE, extra_args=['--dump-format=binary'])
+        dump = cppcheckdata._BinaryDump.open(binary)
+        assert dump.root.tag == 'dumps'
+        assert [tag for tag, offset in dump.sections if tag == 'dump'] == ['dump', 'dump']
+        rawtokens = [dump.load(offset) for tag, offset in dump.sections if tag == 'rawtokens']
+        assert len(rawtokens) == 1
+        assert '"<a & \'b\'>"' in [node.get('str') for node in rawtokens[0] if node.tag == 'tok']
+
+
 class TestPureHelpers:
     """Tests that construct objects from dicts and do not need a dump file."""
 
@@ -430,6 +430,27 @@ typedef int MISRA_5_6_VIOLATION;
     assert stderr == '{}:2:13: style: misra violation (use --rule-texts=<file> to get proper output) [misra-c2012-2.3]\ntypedef int MISRA_5_6_VIOLATION;\n            ^\n'.format(test_file)
 
 
+@pytest.mark.parametrize("extra_args", [['-j1'], ['-j2', '--executor=thread']])
+def test_addon_server(tmpdir, extra_args):
+    test_files = []
+    for i in range(3):
+        test_file = os.path.join(tmpdir, 'test{}.c'.format(i))
+        with open(test_file, 'wt') as f:
+            f.write("""
+typedef int MISRA_5_6_VIOLATION_{};
+            """.format(i))
+        test_files.append(test_file)
+
+    args = ['--addon=misra', '--enable=style', '--template=simple'] + extra_args + test_files
+
+    exitcode, _, stderr = cppcheck(args)
+    assert exitcode == 0, stderr
+    exitcode_server, _, stderr_server = cppcheck(['--addon-server'] + args)
+    assert exitcode_server == 0, stderr_server
+    assert sorted(stderr_server.splitlines()) == sorted(stderr.splitlines())
+    assert len(stderr.splitlines()) == 3
+
+
 def test_addon_y2038(tmpdir):
     test_file = os.path.join(tmpdir, 'test.cpp')
     # TODO: trigger warning
@@ -1008,7 +1029,7 @@ void f()
     if 'cppcheck internal API usage' in stdout:
         exp_len += 1
     if use_addons:
-        exp_len += 1  # TODO: should have individual entries for each addon and whole program analysis
+        exp_len += 4  # CppCheck::dump, CppCheck::executeAddons and an entry for each addon - TODO: should have an entry for the whole program analysis
     # TODO: add entry for clang-tidy analysis
     exp_len += 1  # last line
     assert len(lines) == exp_len
@@ -1044,7 +1065,7 @@ def test_showtime_top5_summary_compdb(tmp_path):
 
 
 def __test_showtime_file(tmp_path, use_compdb=False, use_addons=False, use_clang_tidy=False):
-    exp_res = 79
+    exp_res = 80
     # project analysis does not call Preprocessor::getConfig()
     if use_compdb:
         exp_res -= 1
@@ -1078,7 +1099,7 @@ def test_showtime_file_clang_tidy_compdb(tmp_path):
 
 
 def __test_showtime_summary(tmp_path, use_compdb=False, use_addons=False, use_clang_tidy=False):
-    exp_res = 79
+    exp_res = 80
     # project analysis does not call Preprocessor::getConfig()
     if use_compdb:
         exp_res -= 1
@@ -20,11 +20,18 @@
 #include "analyzerinfo.h"
 #include "errorlogger.h"
 #include "filesettings.h"
+#include "errortypes.h"
 #include "fixture.h"
+#include "helpers.h"
 #include "standards.h"
 
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <list>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "xml.h"
 
@@ -45,6 +52,10 @@ private:
         TEST_CASE(filesTextDuplicateFile);
         TEST_CASE(parse);
         TEST_CASE(skipAnalysis);
+        TEST_CASE(binaryFormat);
+        TEST_CASE(skipAnalysisBinary);
+        TEST_CASE(processFilesTxtParallel);
+        TEST_CASE(wholeProgramCache);
     }
 
     void getAnalyzerInfoFileFromFilesTxt() const {
@@ -268,6 +279,164 @@ private:
             ASSERT_EQUALS(0, errorList.size());
         }
     }
+
+    void binaryFormat() const {
+        const std::string buildDir = "ainfo_binary";
+        ScopedFile filesTxt("files.txt", "file1.a1:::file1.c\n", buildDir);
+
+        ErrorMessage errmsg({ErrorMessage::FileLocation("file1.c", 1, 2)}, "file1.c", Severity::error, "message", "id", Certainty::normal);
+
+        std::list<ErrorMessage> errors;
+        {
+            AnalyzerInformation analyzerInfo(true);
+            ASSERT_EQUALS(true, analyzerInfo.analyzeFile(buildDir, "file1.c", "", 0, 100, errors));
+            analyzerInfo.reportErr(errmsg);
+            analyzerInfo.setFileInfo("ctu", "    <function-call my-id=\"1\"/>\n");
+            analyzerInfo.close();
+        }
+
+        {
+            AnalyzerInformation analyzerInfo(true);
+            ASSERT_EQUALS(true, analyzerInfo.analyzeFile(buildDir, "file1.c", "", 0, 101, errors));
+            ASSERT_EQUALS(0, errors.size());
+        }
+        // the mismatching analysis has overwritten the file
+        {
+            AnalyzerInformation analyzerInfo(true);
+            ASSERT_EQUALS(true, analyzerInfo.analyzeFile(buildDir, "file1.c", "", 0, 100, errors));
+            analyzerInfo.reportErr(errmsg);
+            analyzerInfo.setFileInfo("ctu", "    <function-call my-id=\"1\"/>\n");
+        }
+
+        {
+            AnalyzerInformation analyzerInfo;
+            ASSERT_EQUALS(false, analyzerInfo.analyzeFile(buildDir, "file1.c", "", 0, 100, errors));
+            ASSERT_EQUALS(1, errors.size());
+            ASSERT_EQUALS(errmsg.toXML(), errors.front().toXML());
+        }
+
+        // unmatched suppressions are added afterwards
+        {
+            AnalyzerInformation analyzerInfo;
+            analyzerInfo.reopen(buildDir, "file1.c", "", 0);
+            analyzerInfo.reportErr(errmsg);
+        }
+
+        errors.clear();
+        {
+            AnalyzerInformation analyzerInfo;
+            ASSERT_EQUALS(false, analyzerInfo.analyzeFile(buildDir, "file1.c", "", 0, 100, errors));
+            ASSERT_EQUALS(2, errors.size());
+        }
+
+        std::string fileInfo;
+        const std::string err = AnalyzerInformation::processFilesTxt(buildDir, [&](const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
+            fileInfo += std::string(checkattr) + ":" + filesTxtInfo.sourceFile + ":";
+            for (const tinyxml2::XMLElement *e2 = e->FirstChildElement(); e2; e2 = e2->NextSiblingElement())
+                fileInfo += std::string(e2->Name()) + ",";
+        });
+        ASSERT_EQUALS("", err);
+        ASSERT_EQUALS("ctu:file1.c:function-call,", fileInfo);
+
+        std::remove((buildDir + "/file1.a1").c_str());
+    }
+
+    void processFilesTxtParallel() const {
+        const std::string buildDir = "ainfo_parallel";
+        ScopedFile filesTxt("files.txt", "file1.a1:::file1.c\nfile2.a1:::file2.c\nfile3.a1:::file3.c\nfile4.a1:::file4.c\n", buildDir);
+
+        const auto writeFile = [&](const std::string &name, const std::string &content) {
+            std::ofstream fout(buildDir + "/" + name);
+            fout << content;
+        };
+        writeFile("file1.a1", "<?xml version=\"1.0\"?>\n<analyzerinfo hash=\"1\"><FileInfo check=\"ctu\"><a/></FileInfo><FileInfo check=\"ctu\"><b/></FileInfo></analyzerinfo>\n");
+        // file2.a1 does not exist
+        writeFile("file3.a1", "<?xml version=\"1.0\"?>\n<analyzerinfo hash=\"3\"><FileInfo check=\"ctu\"><c/></FileInfo></analyzerinfo>\n");
+        writeFile("file4.a1", "<?xml version=\"1.0\"?>\n<analyzerinfo hash=\"4\"><FileInfo check=\"ctu\"><d/></FileInfo></analyzerinfo>\n");
+
+        std::vector<AnalyzerInformation::Info> filesTxtInfos;
+        ASSERT_EQUALS("", AnalyzerInformation::readFilesTxt(buildDir, filesTxtInfos));
+        ASSERT_EQUALS(4, filesTxtInfos.size());
+
+        // every file is loaded into its own shard
+        std::vector<std::string> shards(filesTxtInfos.size());
+        const std::string err = AnalyzerInformation::processFilesTxt(buildDir, filesTxtInfos, [&](std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info& filesTxtInfo) {
+            shards[fileIndex] += std::string(checkattr) + ":" + filesTxtInfo.sourceFile + ":" + e->FirstChildElement()->Name() + ",";
+        }, false, 4);
+        ASSERT_EQUALS("", err);
+        ASSERT_EQUALS("ctu:file1.c:a,ctu:file1.c:b,", shards[0]);
+        ASSERT_EQUALS("", shards[1]);
+        ASSERT_EQUALS("ctu:file3.c:c,", shards[2]);
+        ASSERT_EQUALS("ctu:file4.c:d,", shards[3]);
+
+        // the first failure in the order of files.txt is reported
+        writeFile("file3.a1", "<?xml version=\"1.0\"?>\n<analyzerinfo");
+        writeFile("file4.a1", "<?xml version=\"1.0\"?>\n<analyzerinf");
+        ASSERT_EQUALS("failed to load 'ainfo_parallel/file3.a1' from 'ainfo_parallel/files.txt'",
+                      AnalyzerInformation::processFilesTxt(buildDir, filesTxtInfos, [](std::size_t, const char*, const tinyxml2::XMLElement*, const AnalyzerInformation::Info&) {}, false, 4));
+
+        std::remove((buildDir + "/file1.a1").c_str());
+        std::remove((buildDir + "/file3.a1").c_str());
+        std::remove((buildDir + "/file4.a1").c_str());
+        std::remove((buildDir + "/wholeprogram.cache").c_str());
+    }
+
+    void wholeProgramCache() const {
+        const std::string buildDir = "ainfo_wpcache";
+        ScopedFile filesTxt("files.txt", "file1.a1:::file1.c\nfile2.a1:::file2.c\n", buildDir);
+
+        const auto writeFile = [&](const std::string &name, const std::string &hash, const std::string &fileInfo) {
+            std::ofstream fout(buildDir + "/" + name);
+            fout << "<?xml version=\"1.0\"?>\n<analyzerinfo hash=\"" << hash << "\"><FileInfo check=\"ctu\">" << fileInfo << "</FileInfo></analyzerinfo>\n";
+        };
+        const auto process = [&]() {
+            std::vector<AnalyzerInformation::Info> filesTxtInfos;
+            ASSERT_EQUALS("", AnalyzerInformation::readFilesTxt(buildDir, filesTxtInfos));
+            std::vector<std::string> shards(filesTxtInfos.size());
+            ASSERT_EQUALS("", AnalyzerInformation::processFilesTxt(buildDir, filesTxtInfos, [&](std::size_t fileIndex, const char* checkattr, const tinyxml2::XMLElement* e, const AnalyzerInformation::Info&) {
+                for (const tinyxml2::XMLElement *e2 = e->FirstChildElement(); e2; e2 = e2->NextSiblingElement())
+                    shards[fileIndex] += std::string(checkattr) + ":" + e2->Name() + ":" + e2->Attribute("id") + ",";
+            }, false, 2));
+            return shards[0] + shards[1];
+        };
+
+        writeFile("file1.a1", "1", "<a id=\"1\"/><b id=\"2\"/>");
+        writeFile("file2.a1", "2", "<c id=\"3\"/>");
+        ASSERT_EQUALS("ctu:a:1,ctu:b:2,ctu:c:3,", process());
+
+        // the file info of a TU with an unchanged hash is taken from the cache
+        writeFile("file2.a1", "2", "<d id=\"4\"/>");
+        ASSERT_EQUALS("ctu:a:1,ctu:b:2,ctu:c:3,", process());
+
+        // only the changed TU is loaded
+        writeFile("file2.a1", "3", "<e id=\"5\"/>");
+        ASSERT_EQUALS("ctu:a:1,ctu:b:2,ctu:e:5,", process());
+        std::remove((buildDir + "/file1.a1").c_str());
+        ASSERT_EQUALS("ctu:e:5,", process());
+
+        std::remove((buildDir + "/file2.a1").c_str());
+        std::remove((buildDir + "/wholeprogram.cache").c_str());
+    }
+
+    void skipAnalysisBinary() const {
+        std::list<ErrorMessage> errorList;
+        ASSERT_EQUALS("unexpected file format", AnalyzerInformationTest::skipAnalysis(std::string("CPPCHK"), 100, errorList));
+        ASSERT_EQUALS("incomplete header", AnalyzerInformationTest::skipAnalysis(std::string("CPPCHKAI\1\0\0\0", 12), 100, errorList));
+        ASSERT_EQUALS("unsupported version 2", AnalyzerInformationTest::skipAnalysis(std::string("CPPCHKAI\2\0\0\0" "\x64\0\0\0\0\0\0\0", 20), 100, errorList));
+
+        const std::string header("CPPCHKAI\1\0\0\0" "\x64\0\0\0\0\0\0\0", 20);
+        ASSERT_EQUALS("hash mismatch", AnalyzerInformationTest::skipAnalysis(header, 99, errorList));
+        ASSERT_EQUALS("incomplete file", AnalyzerInformationTest::skipAnalysis(header, 100, errorList));
+        ASSERT_EQUALS("", AnalyzerInformationTest::skipAnalysis(header + std::string("Z\0\0\0\0", 5), 100, errorList));
+        ASSERT_EQUALS(0, errorList.size());
+
+        const ErrorMessage internalError({}, "file1.c", Severity::error, "message", "internalError", Certainty::normal);
+        const std::string data = internalError.serialize();
+        const std::string record = 'E' + std::string(1, static_cast<char>(data.size())) + std::string("\0\0\0", 3) + data;
+        ASSERT(data.size() < 256);
+        ASSERT_EQUALS("'internalError' encountered", AnalyzerInformationTest::skipAnalysis(header + record + std::string("Z\0\0\0\0", 5), 100, errorList));
+        ASSERT_EQUALS(0, errorList.size());
+    }
 };
 
 REGISTER_TEST(TestAnalyzerInformation)
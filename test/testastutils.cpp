@@ -45,6 +45,7 @@ private:
         TEST_CASE(isVariableChangedTest);
         TEST_CASE(isVariableChangedByFunctionCallTest);
         TEST_CASE(isExpressionChangedTest);
+        TEST_CASE(mayChangeExpressionTest);
         TEST_CASE(nextAfterAstRightmostLeafTest);
         TEST_CASE(isUsedAsBool);
     }
@@ -449,6 +450,43 @@ private:
                                           "}"));
     }
 
+#define mayChangeExpression(...) mayChangeExpression_(__FILE__, __LINE__, __VA_ARGS__)
+    template<size_t size>
+    bool mayChangeExpression_(const char* file, int line, const char (&code)[size], const char pattern[]) {
+        const Settings settings = settingsBuilder().library("std.cfg").build();
+        SimpleTokenizer tokenizer(settings, *this);
+        ASSERT_LOC(tokenizer.tokenize(code), file, line);
+        // no expression is changed at the other tokens
+        for (const Token* tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if ((::mayChangeExpression)(tok))
+                continue;
+            for (const Token* expr = tokenizer.tokens(); expr; expr = expr->next()) {
+                if (expr->exprId() == 0)
+                    continue;
+                for (int indirect = 0; indirect <= 2; ++indirect) {
+                    ASSERT_LOC_MSG(!isExpressionChangedAt(expr, tok, indirect, false, settings), "changed at " + tok->str(), file, line);
+                    ASSERT_LOC_MSG(!isExpressionChangedAt(expr, tok, indirect, true, settings), "changed at " + tok->str(), file, line);
+                }
+            }
+        }
+        const Token * const tok = Token::findsimplematch(tokenizer.tokens(), pattern, strlen(pattern));
+        return (::mayChangeExpression)(tok);
+    }
+
+    void mayChangeExpressionTest() {
+        ASSERT_EQUALS(false, mayChangeExpression("void f(int x, int y) { if (x < y) {} }", "x <"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(int x, int y) { x = y; }", "x ="));
+        ASSERT_EQUALS(false, mayChangeExpression("void f(int x, int y) { x = y; }", "y ;"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(int x) { x++; }", "x ++"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(int x) { int& r = x; }", "x ;"));
+        ASSERT_EQUALS(true, mayChangeExpression("void g(int&); void f(int x) { g(x); }", "x )"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(int* p) { *(p + 1) = 0; }", "p +"));
+        ASSERT_EQUALS(false, mayChangeExpression("int f(const int* p, int i) { return p[i] + 1; }", "i ]"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(std::istream& is, int x) { is >> x; }", "x ;"));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(std::map<int, int>& m) { if (m[0] == 1) {} }", "m ["));
+        ASSERT_EQUALS(true, mayChangeExpression("void f(std::vector<int>& v) { for (int& x : v) {} }", "v )"));
+    }
+
 #define nextAfterAstRightmostLeaf(...) nextAfterAstRightmostLeaf_(__FILE__, __LINE__, __VA_ARGS__)
     template<size_t size>
     bool nextAfterAstRightmostLeaf_(const char* file, int line, const char (&code)[size], const char parentPattern[], const char rightPattern[]) {
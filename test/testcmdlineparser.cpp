@@ -365,7 +365,17 @@ private:
         TEST_CASE(valueFlowMaxIterationsInvalid);
         TEST_CASE(valueFlowMaxIterationsInvalid2);
         TEST_CASE(valueFlowMaxIterationsInvalid3);
+        TEST_CASE(valueFlowJobs);
+        TEST_CASE(valueFlowJobsZero);
+        TEST_CASE(valueFlowStats);
+        TEST_CASE(valueFlowWorklist);
+        TEST_CASE(checksJobs);
+        TEST_CASE(checksJobsZero);
+        TEST_CASE(checksJobsInvalid);
         TEST_CASE(checksMaxTime);
+        TEST_CASE(configJobs);
+        TEST_CASE(configJobsZero);
+        TEST_CASE(configJobsTooMany);
         TEST_CASE(checksMaxTime2);
         TEST_CASE(checksMaxTimeInvalid);
 #ifdef HAS_THREADING_MODEL_FORK
@@ -399,6 +409,7 @@ private:
         TEST_CASE(projectNoPaths);
         TEST_CASE(addon);
         TEST_CASE(addonMissing);
+        TEST_CASE(addonServer);
 #ifdef HAVE_RULES
         TEST_CASE(rule);
         TEST_CASE(ruleMissingPattern);
@@ -473,6 +484,7 @@ private:
         TEST_CASE(debugLookupPlatform);
         TEST_CASE(maxTemplateRecursion);
         TEST_CASE(maxTemplateRecursionMissingCount);
+        TEST_CASE(memstats);
         TEST_CASE(emitDuplicates);
         TEST_CASE(debugClangOutput);
         TEST_CASE(debugXmlMultiple);
@@ -537,6 +549,14 @@ private:
         TEST_CASE(cppcheckBuildDirMultiple);
         TEST_CASE(noCppcheckBuildDir);
         TEST_CASE(noCppcheckBuildDir2);
+        TEST_CASE(analyzerInfoFormat);
+        TEST_CASE(analyzerInfoFormatInvalid);
+        TEST_CASE(dumpFormat);
+        TEST_CASE(dumpFormatInvalid);
+        TEST_CASE(cacheDir);
+        TEST_CASE(cacheDirNoBuildDir);
+        TEST_CASE(cacheDirNonExistent);
+        TEST_CASE(cacheMaxSize);
 
         TEST_CASE(invalidCppcheckCfg);
 
@@ -2427,6 +2447,55 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--valueflow-max-iterations=' is not valid - needs to be positive.\n", logger->str());
     }
 
+    void valueFlowJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-jobs=4", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(4, settings->valueFlowJobs);
+    }
+
+    void valueFlowJobsZero() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-jobs=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument for '--valueflow-jobs' must be greater than 0.\n", logger->str());
+    }
+
+    void valueFlowStats() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-stats", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT(settings->valueFlowStats);
+    }
+
+    void valueFlowWorklist() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--valueflow-worklist", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT(settings->vfOptions.worklist);
+    }
+
+    void checksJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-jobs=4", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(4, settings->checksJobs);
+    }
+
+    void checksJobsZero() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-jobs=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument for '--checks-jobs' must be greater than 0.\n", logger->str());
+    }
+
+    void checksJobsInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--checks-jobs=one", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument to '--checks-jobs=' is not valid - not an integer (invalid_argument).\n", logger->str());
+    }
+
     void checksMaxTime() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--checks-max-time=12", "file.cpp"};
@@ -2448,6 +2517,27 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--checks-max-time=' is not valid - not an integer (invalid_argument).\n", logger->str());
     }
 
+    void configJobs() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=3", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(3, settings->configJobs);
+    }
+
+    void configJobsZero() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument for '--config-jobs' must be greater than 0.\n", logger->str());
+    }
+
+    void configJobsTooMany() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--config-jobs=1025", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: argument for '--config-jobs' is allowed to be 1024 at max.\n", logger->str());
+    }
+
 #ifdef HAS_THREADING_MODEL_FORK
     void loadAverage() {
         REDIRECT;
@@ -2646,6 +2736,13 @@ private:
         ASSERT_EQUALS("Did not find addon misra2.py\n", logger->str());
     }
 
+    void addonServer() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--addon-server", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(true, settings->addonServer);
+    }
+
     void signedChar() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--fsigned-char", "file.cpp"};
@@ -3260,6 +3357,13 @@ private:
         ASSERT_EQUALS("cppcheck: error: argument to '--max-template-recursion=' is not valid - not an integer (invalid_argument).\n", logger->str());
     }
 
+    void memstats() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--memstats", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(true, settings->memstats);
+    }
+
     void emitDuplicates() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--emit-duplicates", "file.cpp"};
@@ -3753,6 +3857,65 @@ private:
         ASSERT(settings->buildDir.empty());
     }
 
+    void analyzerInfoFormat() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--analyzer-info-format=binary", "file.cpp"};
+        ASSERT_EQUALS_ENUM(Settings::AnalyzerInfoFormat::xml, settings->analyzerInfoFormat);
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::AnalyzerInfoFormat::binary, settings->analyzerInfoFormat);
+    }
+
+    void analyzerInfoFormatInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--analyzer-info-format=json", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: unknown '--analyzer-info-format' value 'json'.\n", logger->str());
+    }
+
+    void dumpFormat() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump", "--dump-format=binary", "file.cpp"};
+        ASSERT_EQUALS_ENUM(Settings::DumpFormat::xml, settings->dumpFormat);
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS_ENUM(Settings::DumpFormat::binary, settings->dumpFormat);
+    }
+
+    void dumpFormatInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump-format=json", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: unknown '--dump-format' value 'json'.\n", logger->str());
+    }
+
+    void cacheDir() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--cppcheck-build-dir=.", "--cache-dir=./", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(".", settings->cacheDir);
+        ASSERT_EQUALS(1024, settings->cacheMaxSize);
+    }
+
+    void cacheDirNoBuildDir() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--cache-dir=.", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: --cache-dir requires --cppcheck-build-dir.\n", logger->str());
+    }
+
+    void cacheDirNonExistent() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--cppcheck-build-dir=.", "--cache-dir=non-existent-path", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Fail, parseFromArgs(argv));
+        ASSERT_EQUALS("cppcheck: error: Directory 'non-existent-path' specified by --cache-dir argument has to be existent.\n", logger->str());
+    }
+
+    void cacheMaxSize() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--cache-max-size=0", "file.cpp"};
+        ASSERT_EQUALS_ENUM(CmdLineParser::Result::Success, parseFromArgs(argv));
+        ASSERT_EQUALS(0, settings->cacheMaxSize);
+    }
+
     void invalidCppcheckCfg() {
         REDIRECT;
         ScopedFile file(Path::join(Path::getPathFromFilename(Path::getCurrentExecutablePath("")), "cppcheck.cfg"),
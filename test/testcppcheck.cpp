@@ -17,6 +17,7 @@
  */
 
 #include "addoninfo.h"
+#include "analyzerinfo.h"
 #include "color.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
@@ -27,6 +28,7 @@
 #include "path.h"
 #include "preprocessor.h"
 #include "redirect.h"
+#include "resultcache.h"
 #include "settings.h"
 #include "standards.h"
 #include "suppressions.h"
@@ -84,6 +86,9 @@ private:
         TEST_CASE(checkPlistOutput);
         TEST_CASE(premiumResultsCache);
         TEST_CASE(purgedConfiguration);
+        TEST_CASE(checksJobs);
+        TEST_CASE(configJobs);
+        TEST_CASE(resultCache);
     }
 
     void getErrorMessages() const {
@@ -621,6 +626,120 @@ private:
                       it->toString(false, templateFormat, ""));
     }
 
+    void checksJobs() const
+    {
+        ScopedFile test_file("checksjobs.cpp",
+                             "void f(int *p) {\n"
+                             "    int a[10];\n"
+                             "    a[10] = 0;\n"
+                             "    *p = 0;\n"
+                             "    if (!p) {}\n"
+                             "    int x;\n"
+                             "    (void)(x + 1);\n"
+                             "}\n");
+
+        const auto check = [&](unsigned int checksJobs) {
+            const auto s = dinit(Settings,
+                                 $.templateFormat = templateFormat,
+                                     $.severity.enable (Severity::warning);
+                                 $.severity.enable (Severity::style);
+                                 $.checksJobs = checksJobs);
+            Suppressions supprs;
+            ErrorLogger2 errorLogger;
+            CppCheck cppcheck(s, supprs, errorLogger, nullptr, false, {});
+            (void)cppcheck.check(FileWithDetails(test_file.path(), Path::identify(test_file.path(), false), 0));
+            std::string output;
+            for (const ErrorMessage& msg : errorLogger.errmsgs)
+                output += msg.toString(false, templateFormat, "") + '\n';
+            return output;
+        };
+
+        const std::string serial = check(1);
+        ASSERT(serial.find("[arrayIndexOutOfBounds]") != std::string::npos);
+        ASSERT(serial.find("[nullPointerRedundantCheck]") != std::string::npos);
+        ASSERT_EQUALS(serial, check(4));
+    }
+
+    void configJobs() const
+    {
+        ScopedFile test_file("configjobs.cpp",
+                             "#ifdef A\n"
+                             "void f() { int a[10]; a[10] = 0; }\n"
+                             "#else\n"
+                             "void f() { int *p = nullptr; *p = 0; }\n"
+                             "#endif\n"
+                             "#ifdef B\n"
+                             "#endif\n"
+                             "void g() { int b[2]; b[2] = 0; }\n");
+
+        const auto check = [&](unsigned int configJobs) {
+            const auto s = dinit(Settings,
+                                 $.templateFormat = templateFormat,
+                                     $.severity.enable (Severity::information);
+                                 $.debugwarnings = true;
+                                 $.configJobs = configJobs);
+            Suppressions supprs;
+            ErrorLogger2 errorLogger;
+            CppCheck cppcheck(s, supprs, errorLogger, nullptr, false, {});
+            (void)cppcheck.check(FileWithDetails(test_file.path(), Path::identify(test_file.path(), false), 0));
+            std::string output;
+            for (const ErrorMessage& msg : errorLogger.errmsgs)
+                output += msg.toString(false, templateFormat, "") + '\n';
+            return output;
+        };
+
+        const std::string serial = check(1);
+        ASSERT(serial.find("[arrayIndexOutOfBounds]") != std::string::npos);
+        ASSERT(serial.find("[nullPointer]") != std::string::npos);
+        ASSERT(serial.find("[purgedConfiguration]") != std::string::npos);
+        ASSERT_EQUALS(serial, check(4));
+    }
+
+    void resultCache() const
+    {
+        const ScopedFile cacheDir("dummy", "", "resultcache_cache");
+        const ScopedFile buildDir1("dummy", "", "resultcache_build1");
+        const ScopedFile buildDir2("dummy", "", "resultcache_build2");
+        ScopedFile test_file("resultcache.cpp",
+                             "void f() { int a[10]; a[10] = 0; }\n");
+
+        const auto check = [&](const std::string& buildDir) {
+            const auto s = dinit(Settings,
+                                 $.templateFormat = templateFormat,
+                                 $.buildDir = buildDir,
+                                 $.cacheDir = "resultcache_cache");
+            Suppressions supprs;
+            ErrorLogger2 errorLogger;
+            CppCheck cppcheck(s, supprs, errorLogger, nullptr, false, {});
+            (void)cppcheck.check(FileWithDetails(test_file.path(), Path::identify(test_file.path(), false), 0));
+            std::string output;
+            for (const ErrorMessage& msg : errorLogger.errmsgs) {
+                // the active checkers are only reported when the file is analyzed
+                if (msg.id != "logChecker")
+                    output += msg.toString(false, templateFormat, "") + '\n';
+            }
+            return output;
+        };
+
+        const ResultCache::Statistics before = ResultCache::getStatistics();
+
+        const std::string output = check("resultcache_build1");
+        ASSERT(output.find("[arrayIndexOutOfBounds]") != std::string::npos);
+
+        // a different build dir gets the results from the result cache
+        ASSERT_EQUALS(output, check("resultcache_build2"));
+
+        const ResultCache::Statistics after = ResultCache::getStatistics();
+        ASSERT_EQUALS(1, after.hits - before.hits);
+        ASSERT_EQUALS(1, after.misses - before.misses);
+        ASSERT_EQUALS(1, after.stores - before.stores);
+
+        std::remove(AnalyzerInformation::getAnalyzerInfoFile("resultcache_build1", test_file.path(), "", 0).c_str());
+        std::remove("resultcache_build1/resultcache.cpp.snalyzerinfo");
+        std::remove(AnalyzerInformation::getAnalyzerInfoFile("resultcache_build2", test_file.path(), "", 0).c_str());
+        ASSERT_EQUALS(1, ResultCache("resultcache_cache").evict(0));
+    }
+
     // TODO: test suppressions
     // TODO: test all with FS
 };
@@ -55,6 +55,7 @@ private:
         TEST_CASE(ErrorMessageVerboseNewline);
         TEST_CASE(ErrorMessageFromInternalError);
         TEST_CASE(ErrorMessageCode);
+        TEST_CASE(ErrorMessageCodeLines);
         TEST_CASE(CustomFormat);
         TEST_CASE(CustomFormat2);
         TEST_CASE(CustomFormatLocations);
@@ -386,6 +387,38 @@ private:
                       msg.toString(false, "{file}:{line}:{column}: {severity}:{inconclusive:inconclusive:} {message} [{id}]\n{code}", ""));
     }
 
+    void ErrorMessageCodeLines() const {
+        const auto code = [](const std::string &file, int line) {
+            std::list<ErrorMessage::FileLocation> locs = { ErrorMessage::FileLocation{file, line, 1} };
+            const ErrorMessage msg(std::move(locs), "", Severity::error, "Programming error.", "errorId", Certainty::normal);
+            return msg.toString(false, "{code}", "");
+        };
+
+        {
+            ScopedFile file("code_lines.cpp",
+                            "int i;\r\n"
+                            "\tint i2;  \n"
+                            "\n"
+                            "int i4;");
+            ASSERT_EQUALS("int i4;\n^", code(file.path(), 4));
+            ASSERT_EQUALS("int i;\n^", code(file.path(), 1));
+            ASSERT_EQUALS(" int i2;\n^", code(file.path(), 2));
+            ASSERT_EQUALS("\n^", code(file.path(), 3));
+            // like std::getline() the last line is kept
+            ASSERT_EQUALS("int i4;\n^", code(file.path(), 5));
+            ASSERT_EQUALS("\n^", code(file.path(), 0));
+        }
+        {
+            // a modified file is read again
+            ScopedFile file("code_lines.cpp",
+                            "int j;\n"
+                            "int j2;\n");
+            ASSERT_EQUALS("int j2;\n^", code(file.path(), 2));
+            ASSERT_EQUALS("\n^", code(file.path(), 3));
+        }
+        ASSERT_EQUALS("\n^", code("code_lines.cpp", 1));
+    }
+
     void CustomFormat() const {
         std::list<ErrorMessage::FileLocation> locs(1, fooCpp5);
         ErrorMessage msg(std::move(locs), "", Severity::error, "Programming error.\nVerbose error", "errorId", Certainty::normal);
@@ -0,0 +1,104 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fixture.h"
+#include "headercache.h"
+#include "helpers.h"
+
+#include <string>
+#include <vector>
+
+#include <simplecpp.h>
+
+class TestHeaderCache : public TestFixture {
+public:
+    TestHeaderCache() : TestFixture("TestHeaderCache") {}
+
+private:
+    void run() override {
+        TEST_CASE(hit);
+        TEST_CASE(modified);
+        TEST_CASE(evict);
+        TEST_CASE(disabled);
+    }
+
+    void hit() const {
+        const ScopedFile header("headercache_hit.h", "#define A 1\nint a = A;\n");
+        HeaderCache headerCache(1000);
+
+        std::vector<std::string> files1;
+        const simplecpp::TokenList tokens1 = headerCache.tokenize(header.path(), files1, nullptr);
+
+        // the file index of the copy refers to the files of the translation unit
+        std::vector<std::string> files2{"main.c"};
+        const simplecpp::TokenList tokens2 = headerCache.tokenize(header.path(), files2, nullptr);
+
+        ASSERT_EQUALS(1, headerCache.getStatistics().hits);
+        ASSERT_EQUALS(1, headerCache.getStatistics().misses);
+
+        std::vector<std::string> files3{"main.c"};
+        const simplecpp::TokenList tokens3(header.path(), files3);
+        ASSERT_EQUALS(tokens3.stringify(true), tokens2.stringify(true));
+        ASSERT_EQUALS(2U, files2.size());
+        ASSERT_EQUALS(header.path(), files2[1]);
+        ASSERT_EQUALS(1U, tokens2.cfront()->location.fileIndex);
+        ASSERT_EQUALS(1U, tokens2.cback()->location.fileIndex);
+        ASSERT_EQUALS("# define A 1\nint a = A ;", tokens1.stringify());
+    }
+
+    void modified() const {
+        HeaderCache headerCache(1000);
+        std::vector<std::string> files;
+        {
+            const ScopedFile header("headercache_modified.h", "int a;\n");
+            (void)headerCache.tokenize(header.path(), files, nullptr);
+        }
+        const ScopedFile header("headercache_modified.h", "int b;\n");
+        const simplecpp::TokenList tokens = headerCache.tokenize(header.path(), files, nullptr);
+        ASSERT_EQUALS(0, headerCache.getStatistics().hits);
+        ASSERT_EQUALS(2, headerCache.getStatistics().misses);
+        ASSERT_EQUALS("int b ;", tokens.stringify());
+    }
+
+    void evict() const {
+        const ScopedFile header1("headercache_evict1.h", "int a;\n");
+        const ScopedFile header2("headercache_evict2.h", "int b;\n");
+        // only one file fits
+        HeaderCache headerCache(4);
+        std::vector<std::string> files;
+        (void)headerCache.tokenize(header1.path(), files, nullptr);
+        (void)headerCache.tokenize(header2.path(), files, nullptr);
+        (void)headerCache.tokenize(header2.path(), files, nullptr);
+        (void)headerCache.tokenize(header1.path(), files, nullptr);
+        ASSERT_EQUALS(1, headerCache.getStatistics().hits);
+        ASSERT_EQUALS(3, headerCache.getStatistics().misses);
+    }
+
+    void disabled() const {
+        const ScopedFile header("headercache_disabled.h", "int a;\n");
+        HeaderCache headerCache(0);
+        std::vector<std::string> files;
+        (void)headerCache.tokenize(header.path(), files, nullptr);
+        const simplecpp::TokenList tokens = headerCache.tokenize(header.path(), files, nullptr);
+        ASSERT_EQUALS(0, headerCache.getStatistics().hits);
+        ASSERT_EQUALS(0, headerCache.getStatistics().misses);
+        ASSERT_EQUALS("int a ;", tokens.stringify());
+    }
+};
+
+REGISTER_TEST(TestHeaderCache)
@@ -56,6 +56,7 @@ private:
         TEST_CASE(function_namespace);
         TEST_CASE(function_method);
         TEST_CASE(function_baseClassMethod); // calling method in base class
+        TEST_CASE(function_nameMemoized);
         TEST_CASE(function_warn);
         TEST_CASE(memory);
         TEST_CASE(memory2); // define extra "free" allocation functions
@@ -608,6 +609,27 @@ private:
         }
     }
 
+    void function_nameMemoized() {
+        constexpr char xmldata[] = "<?xml version=\"1.0\"?>\n"
+                                   "<def>\n"
+                                   "  <function name=\"Base::f\">\n"
+                                   "    <arg nr=\"1\"><not-null/></arg>\n"
+                                   "  </function>\n"
+                                   "</def>";
+        const Settings settings = settingsBuilder().libraryxml(xmldata).build();
+
+        SimpleTokenizer tokenizer(settings, *this);
+        const char code[] = "struct X : public Base { void dostuff() { f(0); } };";
+        ASSERT(tokenizer.tokenize(code));
+        const Token *ftok = Token::findsimplematch(tokenizer.tokens(), "f");
+        // the name is only memoized for the library of the tokenizer
+        ASSERT(ftok->libraryFunctionName(settings.library) != nullptr);
+        ASSERT_EQUALS("Base::f", *ftok->libraryFunctionName(settings.library));
+        ASSERT(ftok->libraryFunctionName(settingsDefault.library) == nullptr);
+        ASSERT_EQUALS("Base::f", settings.library.getFunctionName(ftok));
+        ASSERT(settings.library.isnullargbad(ftok, 1));
+    }
+
     void function_warn() const {
         constexpr char xmldata[] = "<?xml version=\"1.0\"?>\n"
                                    "<def>\n"
@@ -29,6 +29,7 @@
 #include "suppressions.h"
 #include "timer.h"
 
+#include <cstddef>
 #include <cstdlib>
 #include <list>
 #include <memory>
@@ -66,6 +67,7 @@ private:
         bool quiet = true;
         Settings::ShowTime showtime = Settings::ShowTime::NONE;
         const char* plistOutput = nullptr;
+        std::size_t* duplicateCount = nullptr;
         std::vector<std::string> filesList;
     };
 
@@ -124,6 +126,8 @@ private:
 
         ProcessExecutor executor(filelist, fileSettings, s, supprs, *this, timerResults.get(), executeFn);
         ASSERT_EQUALS(result, executor.check());
+        if (opt.duplicateCount)
+            *opt.duplicateCount = executor.getDuplicateCount();
     }
 #endif // HAS_THREADING_MODEL_FORK
 
@@ -131,6 +135,7 @@ private:
         mNewTemplate = true;
 #ifdef HAS_THREADING_MODEL_FORK
         TEST_CASE(deadlock_with_many_errors);
+        TEST_CASE(many_errors_batched);
         TEST_CASE(many_threads);
         TEST_CASE(many_threads_showtime);
         TEST_CASE(many_threads_plist);
@@ -162,6 +167,17 @@ private:
         ASSERT_EQUALS(1LL * num_err * num_files, cppcheck::count_all_of(errout_str(), "(error) Null pointer dereference: (int*)0"));
     }
 
+    // the messages exceed the size of a single batch
+    void many_errors_batched() {
+        std::ostringstream oss;
+        const int num_err = 500;
+        for (int i = 0; i < num_err; i++) {
+            oss << "void f" << i << "() { (void)(*((int*)0)); }\n";
+        }
+        check(2, 2, 2, oss.str());
+        ASSERT_EQUALS(2LL * num_err, cppcheck::count_all_of(errout_str(), "(error) Null pointer dereference: (int*)0"));
+    }
+
     void many_threads() {
         const int num_files = 100;
         check(16, num_files, num_files,
@@ -296,10 +312,13 @@ private:
                          "{\n"
                          "  (void)(*((int*)0));\n"
                          "}");
+        std::size_t duplicateCount = 0;
         check(2, 2, 2,
-              "#include \"" + inc_h.name() +"\"");
+              "#include \"" + inc_h.name() +"\"",
+              dinit(CheckOptions, $.duplicateCount = &duplicateCount));
         // this is made unique by the executor
         ASSERT_EQUALS("[" + inc_h.name() + ":3:12]: (error) Null pointer dereference: (int*)0 [nullPointer]\n", errout_str());
+        ASSERT_EQUALS(1, duplicateCount);
     }
 
     // TODO: test whole program analysis
@@ -0,0 +1,124 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2026 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fixture.h"
+#include "helpers.h"
+#include "resultcache.h"
+
+#include <string>
+#include <utility>
+
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <utime.h>
+#else
+#include <sys/utime.h>
+#endif
+
+class TestResultCache : public TestFixture {
+public:
+    TestResultCache() : TestFixture("TestResultCache") {}
+
+private:
+    class ResultCacheTest final : public ResultCache
+    {
+        friend class TestResultCache;
+    public:
+        explicit ResultCacheTest(std::string dir) : ResultCache(std::move(dir)) {}
+    };
+
+    void run() override {
+        TEST_CASE(getKey);
+        TEST_CASE(storeAndLoad);
+        TEST_CASE(evict);
+    }
+
+    void getKey() const {
+        const std::string key = ResultCache::getKey(123, "src/file1.c", "");
+        ASSERT_EQUALS(sizeof(std::size_t) * 2, key.size());
+        ASSERT_EQUALS(key, ResultCache::getKey(123, "src/file1.c", ""));
+        ASSERT_EQUALS(key, ResultCache::getKey(123, "src/./file1.c", ""));
+        ASSERT(key != ResultCache::getKey(124, "src/file1.c", ""));
+        ASSERT(key != ResultCache::getKey(123, "src/file2.c", ""));
+        ASSERT(key != ResultCache::getKey(123, "src/file1.c", "Debug"));
+    }
+
+    void storeAndLoad() const {
+        const std::string dir = "resultcache_store";
+        ScopedFile dummy("dummy", "", dir);
+        const ResultCache resultCache(dir);
+
+        const ResultCache::Statistics before = ResultCache::getStatistics();
+
+        std::string content;
+        ASSERT(!resultCache.load("0123", content));
+
+        resultCache.store("0123", "<analyzerinfo/>\n");
+        ASSERT(resultCache.load("0123", content));
+        ASSERT_EQUALS("<analyzerinfo/>\n", content);
+
+        // an existing entry is replaced
+        resultCache.store("0123", "<analyzerinfo hash=\"1\"/>\n");
+        ASSERT(resultCache.load("0123", content));
+        ASSERT_EQUALS("<analyzerinfo hash=\"1\"/>\n", content);
+
+        const ResultCache::Statistics after = ResultCache::getStatistics();
+        ASSERT_EQUALS(2, after.hits - before.hits);
+        ASSERT_EQUALS(1, after.misses - before.misses);
+        ASSERT_EQUALS(2, after.stores - before.stores);
+
+        ASSERT_EQUALS(1, resultCache.evict(0));
+    }
+
+    void evict() const {
+        const std::string dir = "resultcache_evict";
+        ScopedFile dummy("dummy", "", dir);
+        const ResultCacheTest resultCache(dir);
+
+        const std::string content(100, 'x');
+        resultCache.store("a", content);
+        resultCache.store("b", content);
+        resultCache.store("c", content);
+
+        // make the entries look like they were used in the order a, b, c
+        utimbuf times;
+        times.actime = times.modtime = 1000;
+        utime(resultCache.getEntryFile("a").c_str(), &times);
+        times.actime = times.modtime = 2000;
+        utime(resultCache.getEntryFile("b").c_str(), &times);
+        times.actime = times.modtime = 3000;
+        utime(resultCache.getEntryFile("c").c_str(), &times);
+
+        ASSERT_EQUALS(0, resultCache.evict(300));
+
+        // loading an entry marks it as recently used
+        std::string s;
+        ASSERT(resultCache.load("a", s));
+
+        ASSERT_EQUALS(1, resultCache.evict(250));
+        ASSERT(resultCache.load("a", s));
+        ASSERT(!resultCache.load("b", s));
+        ASSERT(resultCache.load("c", s));
+
+        ASSERT_EQUALS(2, resultCache.evict(0));
+    }
+};
+
+REGISTER_TEST(TestResultCache)
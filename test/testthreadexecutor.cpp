@@ -29,7 +29,11 @@
 #include "threadexecutor.h"
 #include "timer.h"
 
+#include <cstddef>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <iterator>
 #include <list>
 #include <memory>
 #include <sstream>
@@ -66,6 +70,8 @@ private:
         bool quiet = true;
         Settings::ShowTime showtime = Settings::ShowTime::NONE;
         const char* plistOutput = nullptr;
+        const char* buildDir = nullptr;
+        std::size_t* duplicateCount = nullptr;
         std::vector<std::string> filesList;
     };
 
@@ -102,6 +108,8 @@ private:
         s.quiet = opt.quiet;
         if (opt.plistOutput)
             s.plistOutput = opt.plistOutput;
+        if (opt.buildDir)
+            s.buildDir = opt.buildDir;
         s.templateFormat = "{callstack}: ({severity}) {inconclusive:inconclusive: }{message}"; // TODO: remove when we only longer rely on toString() in unique message handling?
 
         Suppressions supprs;
@@ -125,6 +133,8 @@ private:
 
         ThreadExecutor executor(filelist, fileSettings, s, supprs, *this, timerResults.get(), executeFn);
         ASSERT_EQUALS(result, executor.check());
+        if (opt.duplicateCount)
+            *opt.duplicateCount = executor.getDuplicateCount();
     }
 #endif // HAS_THREADING_MODEL_THREAD
 
@@ -145,6 +155,7 @@ private:
         TEST_CASE(showtime_file_total);
         TEST_CASE(suppress_error_library);
         TEST_CASE(unique_errors);
+        TEST_CASE(timings);
 #endif // HAS_THREADING_MODEL_THREAD
     }
 
@@ -183,6 +194,9 @@ private:
               "}", dinit(CheckOptions, $.showtime = Settings::ShowTime::SUMMARY));
         // we are not interested in the results - so just consume them
         ignore_errout();
+        const std::string output_s = output_str();
+        ASSERT(output_s.find("Thread executor wall time: ") != std::string::npos);
+        ASSERT_EQUALS(16, cppcheck::count_all_of(output_s, "\nWorker "));
     }
 
     void many_threads_plist() {
@@ -297,10 +311,40 @@ private:
                          "{\n"
                          "  (void)(*((int*)0));\n"
                          "}");
+        std::size_t duplicateCount = 0;
         check(2, 2, 2,
-              "#include \"" + inc_h.name() +"\"");
+              "#include \"" + inc_h.name() +"\"",
+              dinit(CheckOptions, $.duplicateCount = &duplicateCount));
         // this is made unique by the executor
         ASSERT_EQUALS("[" + inc_h.name() + ":3:12]: (error) Null pointer dereference: (int*)0 [nullPointer]\n", errout_str());
+        ASSERT_EQUALS(1, duplicateCount);
+    }
+
+    void timings() {
+        const std::string buildDir = "timings_" + fprefix();
+        ScopedFile dummy("dummy", "", buildDir);
+
+        check(2, 2, 0,
+              "int main() {}",
+              dinit(CheckOptions, $.buildDir = buildDir.c_str()));
+
+        const std::string timingsTxt = buildDir + "/timings.txt";
+        std::string content;
+        {
+            std::ifstream fin(timingsTxt);
+            ASSERT(fin.is_open());
+            content.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        }
+        ASSERT_EQUALS(2, cppcheck::count_all_of(content, '\n'));
+        ASSERT(content.find(":" + fprefix() + "_1.c\n") != std::string::npos);
+        ASSERT(content.find(":" + fprefix() + "_2.c\n") != std::string::npos);
+
+        std::remove(timingsTxt.c_str());
+        for (int i = 1; i <= 2; ++i) {
+            const std::string base = buildDir + "/" + fprefix() + "_" + std::to_string(i) + ".c.";
+            std::remove((base + "analyzerinfo").c_str());
+            std::remove((base + "snalyzerinfo").c_str());
+        }
     }
 
     // TODO: test whole program analysis
@@ -133,6 +133,9 @@ private:
         TEST_CASE(update_property_info_replace); // #13743
 
         TEST_CASE(varid_reset);
+
+        TEST_CASE(arenaRecycle);
+        TEST_CASE(internedStrings);
     }
 
     void nextprevious() const {
@@ -1515,6 +1518,47 @@ private:
         assert_tok(&tok, Token::Type::eType, /*l=*/ false, /*std=*/ true);
     }
 #undef assert_tok
+
+    void arenaRecycle() const {
+        TokenList tokenlist{settingsDefault, Standards::Language::C};
+        tokenlist.appendFileIfNew("test.c");
+        tokenlist.addtoken("a", 1, 1, 0);
+        tokenlist.addtoken("b", 1, 3, 0);
+        tokenlist.addtoken("c", 1, 5, 0);
+        Token *front = tokenlist.front();
+        const Token *deleted = front->next();
+        front->deleteNext();
+        ASSERT_EQUALS("a c", front->stringifyList(nullptr, false));
+
+        // the memory of the deleted token is reused
+        front->insertToken("d");
+        ASSERT(front->next() == deleted);
+        ASSERT_EQUALS("a d c", front->stringifyList(nullptr, false));
+        ASSERT_EQUALS(1, front->next()->linenr());
+        ASSERT(front->next()->originalName().empty());
+    }
+
+    void internedStrings() const {
+        TokenList tokenlist{settingsDefault, Standards::Language::C};
+        tokenlist.appendFileIfNew("test.c");
+        tokenlist.addtoken("x", 1, 1, 0);
+        tokenlist.addtoken("=", 1, 3, 0);
+        tokenlist.addtoken("x", 1, 5, 0);
+        Token *front = tokenlist.front();
+        const Token *back = tokenlist.back();
+        ASSERT(&front->str() == &back->str());
+
+        // the old string stays valid
+        const std::string &s = front->str();
+        front->str("y");
+        ASSERT_EQUALS("x", s);
+        ASSERT_EQUALS("y", front->str());
+        ASSERT(&front->str() != &back->str());
+
+        front->str("x");
+        ASSERT(&front->str() == &back->str());
+        ASSERT(front->isName());
+    }
 };
 
 REGISTER_TEST(TestToken)
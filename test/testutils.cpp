@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -45,6 +46,7 @@ private:
         TEST_CASE(as_const);
         TEST_CASE(memoize);
         TEST_CASE(endsWith);
+        TEST_CASE(writeChunk);
     }
 
     void isValidGlobPattern() const {
@@ -612,6 +614,23 @@ private:
         ASSERT(!::endsWith("tes", "test"));
         ASSERT(!::endsWith("2test", "2"));
     }
+
+    void writeChunk() const
+    {
+        std::ostringstream out;
+        std::string buffer = "abc";
+        ::writeChunk(out, buffer, 4);
+        ASSERT_EQUALS("", out.str());
+        ASSERT_EQUALS("abc", buffer);
+        buffer += "d";
+        ::writeChunk(out, buffer, 4);
+        ASSERT_EQUALS("abcd", out.str());
+        ASSERT_EQUALS("", buffer);
+        buffer = "efghi";
+        ::writeChunk(out, buffer, 4);
+        ASSERT_EQUALS("abcdefghi", out.str());
+        ASSERT_EQUALS("", buffer);
+    }
 };
 
 REGISTER_TEST(TestUtils)
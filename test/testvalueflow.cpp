@@ -170,6 +170,8 @@ private:
         mNewTemplate = true;
 
         TEST_CASE(performanceIfCount);
+        TEST_CASE(valueFlowJobs);
+        TEST_CASE(valueFlowWorklist);
         TEST_CASE(bitfields);
 
         TEST_CASE(bitfieldsHang);
@@ -500,7 +502,7 @@ private:
         SimpleTokenizer tokenizer(s ? *s : settings, *this, cpp);
         ASSERT_LOC(tokenizer.tokenize(code), file, line);
         const Token *tok = Token::findmatch(tokenizer.tokens(), tokstr);
-        return tok ? tok->values() : std::list<ValueFlow::Value>();
+        return tok ? std::list<ValueFlow::Value>(tok->values().cbegin(), tok->values().cend()) : std::list<ValueFlow::Value>();
     }
 
     std::list<ValueFlow::Value> tokenValues_(const char* file, int line, const char code[], const char tokstr[], ValueFlow::Value::ValueType vt) {
@@ -520,7 +522,7 @@ private:
         const Token* tok = Token::findmatch(tokenizer.tokens(), tokstr);
         if (!tok)
             return "";
-        const std::list<ValueFlow::Value>& values = tok->values();
+        const std::vector<ValueFlow::Value>& values = tok->values();
         const auto it = std::find_if(values.cbegin(), values.cend(), [](const ValueFlow::Value& v) {
             return v.isContainerSizeValue() && v.container;
         });
@@ -9726,6 +9728,75 @@ private:
         ASSERT_EQUALS(1U, tokenValues(code, "v .", &s).size());
     }
 
+#define sameValues(...) sameValues_(__FILE__, __LINE__, __VA_ARGS__)
+    // the values are the same as with the default settings
+    void sameValues_(const char* file, int line, const char code[], const Settings &s) {
+        SimpleTokenizer tokenizer1(settings, *this);
+        ASSERT_LOC(tokenizer1.tokenize(code), file, line);
+        SimpleTokenizer tokenizer2(s, *this);
+        ASSERT_LOC(tokenizer2.tokenize(code), file, line);
+
+        const Token *tok2 = tokenizer2.tokens();
+        for (const Token *tok1 = tokenizer1.tokens(); tok1; tok1 = tok1->next(), tok2 = tok2->next()) {
+            ASSERT_LOC(tok2 != nullptr, file, line);
+            ASSERT_EQUALS_LOC(tok1->str(), tok2->str(), file, line);
+            ASSERT_EQUALS_LOC(tok1->values().size(), tok2->values().size(), file, line);
+            for (std::size_t i = 0; i < tok1->values().size(); ++i)
+                ASSERT_EQUALS_LOC(tok1->values()[i].toString(), tok2->values()[i].toString(), file, line);
+        }
+        ASSERT_LOC(tok2 == nullptr, file, line);
+    }
+
+    const char * const scopeGroupsCode = "int g(int x) {\n"
+                                         "  if (x > 10) { return x - 1; }\n"
+                                         "  return 0;\n"
+                                         "}\n"
+                                         "int h(int y) {\n"
+                                         "  int a = 3;\n"
+                                         "  for (int i = 0; i < 10; i++) { a += i; }\n"
+                                         "  return g(y) + a;\n"
+                                         "}\n"
+                                         "void f1(int *p) {\n"
+                                         "  int b = h(2);\n"
+                                         "  if (p == nullptr) { b = *p; }\n"
+                                         "}\n"
+                                         "void f2() {\n"
+                                         "  auto l = [](int z) { return z == 1 ? 5 : 6; };\n"
+                                         "  int c = l(1);\n"
+                                         "  int d = c;\n"
+                                         "}\n";
+
+    void valueFlowJobs() {
+        /*const*/ Settings s(settings);
+        s.valueFlowJobs = 4;
+        sameValues(scopeGroupsCode, s);
+    }
+
+    void valueFlowWorklist() {
+        /*const*/ Settings s(settings);
+        s.vfOptions.worklist = true;
+        sameValues(scopeGroupsCode, s);
+
+        s.valueFlowStats = true;
+        SimpleTokenizer tokenizer(s, *this);
+        ASSERT(tokenizer.tokenize("int g(int x) {\n"
+                                  "  int a = x;\n"
+                                  "  return a + 1;\n"
+                                  "}\n"
+                                  "int f() {\n"
+                                  "  return g(3);\n"
+                                  "}\n"
+                                  "int h(int y) {\n"
+                                  "  int b = y;\n"
+                                  "  return b;\n"
+                                  "}\n"));
+        // the value of the parameter of g() is known after the first iteration, h() is not analysed again
+        const std::string output = output_str();
+        ASSERT(output.find("ValueFlow: test.cpp: iteration 1: 2 changed tokens, 18 analysed and 0 skipped scope groups\n") != std::string::npos);
+        ASSERT(output.find("ValueFlow: test.cpp: iteration 2: 2 changed tokens, 12 analysed and 6 skipped scope groups\n") != std::string::npos);
+        ASSERT(output.find("ValueFlow: test.cpp: valueFlowAfterAssign(tokenlist, scopeGroups, errorLogger, settings, skippedFunctions): 3 iterations, 2 changed tokens\n") != std::string::npos);
+    }
+
 #define testBitfields(...) testBitfields_(__FILE__, __LINE__, __VA_ARGS__)
     void testBitfields_(const char *file, int line, const std::string &structBody, std::size_t expectedSize) {
         const Settings settingsUnix64 = settingsBuilder().platform(Platform::Type::Unix64).build();
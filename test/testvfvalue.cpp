@@ -17,6 +17,7 @@
  */
 
 #include "fixture.h"
+#include "errortypes.h"
 #include "vfvalue.h"
 
 class TestValueFlowValue : public TestFixture {
@@ -26,6 +27,7 @@ public:
 private:
     void run() override {
         TEST_CASE(toString);
+        TEST_CASE(sharedErrorPath);
     }
 
     void toString() const {
@@ -43,6 +45,20 @@ private:
             ASSERT_EQUALS("1e-13", v.toString());
         }
     }
+
+    void sharedErrorPath() const {
+        ValueFlow::Value v1;
+        v1.errorPath.emplace_back(nullptr, "first");
+        ValueFlow::Value v2 = v1;
+        // the copy shares the path until it is modified
+        ASSERT(&v1.errorPath.get() == &v2.errorPath.get());
+        v2.errorPath.emplace_back(nullptr, "second");
+        ASSERT(&v1.errorPath.get() != &v2.errorPath.get());
+        ASSERT_EQUALS(1U, v1.errorPath.size());
+        ASSERT_EQUALS(2U, v2.errorPath.size());
+        ASSERT_EQUALS("first", v1.errorPath.back().second);
+        ASSERT_EQUALS("second", v2.errorPath.back().second);
+    }
 };
 
 REGISTER_TEST(TestValueFlowValue)